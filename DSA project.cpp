@@ -1,12 +1,46 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#ifdef __linux__
+#include <csignal>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
 using namespace std;
 
 // Constants
 const int MAX_DAYS = 30; // Maximum days for room availability
+const int HISTORY_CHUNK_SIZE = 4096; // Booking history records per chunk
+const int MAINTENANCE_SLICE = 256;   // Booked nights recycled per maintenance slice
+const int NAME_PAGE_SIZE = 1024;     // Customer names per history name page
+const int ROOM_PAGE_SIZE = 256;      // Rooms per copy-on-write room page
+const int PIPELINE_QUEUE_SIZE = 1024; // Requests held between two pipeline stages
 
 // Define Room structure
 struct Room
@@ -26,7 +60,7 @@ struct Room
         UNAVAILABLE
     } status;
     int floorNumber;
-    bool availabilityCalendar[MAX_DAYS]; // Availability for next 30 days
+    bool availabilityCalendar[MAX_DAYS]; // Availability by day % MAX_DAYS for the next 30 days
 
     Room(int id, RoomType type, Status status, int floor)
         : id(id), type(type), status(status), floorNumber(floor)
@@ -46,19 +80,103 @@ struct BookingRequest
     Room::RoomType requestedType;
     int nights;
     int floornum;
-    int checkInDay; // Day number (0-29) for check-in
+    int checkInDay; // Day number for check-in, counted from the hotel's day 0
     bool isHighPriority;
+    int ticket; // Caller's reference for the outcome, 0 when not needed
     BookingRequest *next;
 };
 
-// Define BookingHistory structure
+// Display names indexed by Room::RoomType and Room::Status
+const char *const ROOM_TYPE_LABELS[] = {"Single", "Double", "Suite"};
+const char *const ROOM_STATUS_LABELS[] = {"Occupied", "Booked", "Ready", "Unavailable"};
+
+// Define BookingHistory structure (one record of the booking history)
 struct BookingHistory
 {
     string customerName;
     Room::RoomType roomType;
     int roomId;
     int nights;
-    BookingHistory *next;
+    int checkInDay;
+    int groupId;  // 0 for individual bookings
+    int bookedAt; // Seconds since the history was created, set on push and kept by append
+};
+
+// Define HistoryChunk structure
+// Booking history is stored column by column in fixed-size chunks. Each chunk
+// keeps min/max summaries so queries can skip chunks that cannot match.
+struct HistoryChunk
+{
+    int count;
+    int customerId[HISTORY_CHUNK_SIZE];
+    int roomId[HISTORY_CHUNK_SIZE];
+    int groupId[HISTORY_CHUNK_SIZE];
+    int bookedAt[HISTORY_CHUNK_SIZE];
+    unsigned short checkInDay[HISTORY_CHUNK_SIZE];
+    unsigned char nights[HISTORY_CHUNK_SIZE];
+    unsigned char roomType[HISTORY_CHUNK_SIZE];
+    unsigned char archived[HISTORY_CHUNK_SIZE]; // Set once the stay is over
+
+    // Summaries (only ever widened, so they stay valid after a pop)
+    int minRoomId;
+    int maxRoomId;
+    int minCheckIn;
+    int maxCheckOut;
+    int archivedCount;
+    long long epoch; // Snapshot epoch this copy belongs to, see writablePage
+
+    explicit HistoryChunk(long long epoch = 0)
+        : count(0), minRoomId(0), maxRoomId(0), minCheckIn(0), maxCheckOut(0), archivedCount(0), epoch(epoch) {}
+};
+
+// Define NamePage structure (customer names in id order)
+struct NamePage
+{
+    int count;
+    string names[NAME_PAGE_SIZE];
+    long long epoch;
+
+    explicit NamePage(long long epoch = 0) : count(0), epoch(epoch) {}
+};
+
+// Define RoomPage structure (copies of consecutive rooms, published for readers)
+struct RoomPage
+{
+    vector<Room> rooms;
+    long long epoch;
+
+    explicit RoomPage(long long epoch = 0) : epoch(epoch) {}
+};
+
+// Copy-on-write for snapshot pages. Every snapshot starts a new epoch, and a
+// page from an earlier epoch may still be read through one, so it is copied
+// before the writer changes it. use_count() cannot decide this: it is a relaxed
+// load, so a count of 1 does not order the writer after a reader that has just
+// let go. Call with the owner's viewLock held.
+template <typename Page>
+Page *writablePage(shared_ptr<Page> &page, long long epoch)
+{
+    if (page->epoch != epoch)
+    {
+        page = make_shared<Page>(*page);
+        page->epoch = epoch;
+    }
+    return page.get();
+}
+
+// Define NightEntry structure (one booked night, recycled by the day rollover)
+struct NightEntry
+{
+    Room *room;
+    int historyIndex;
+};
+
+// Define WaitlistEntry structure
+struct WaitlistEntry
+{
+    BookingRequest *request;
+    chrono::steady_clock::time_point waitlistedAt;
+    WaitlistEntry *next;
 };
 
 // Define TreeNode for representing hotel floors and rooms
@@ -77,11 +195,13 @@ struct BookingQueue
 {
     BookingRequest *front;
     BookingRequest *rear;
+    mutex viewLock; // Held while the queue changes so snapshot() sees a whole queue
 
     BookingQueue() : front(nullptr), rear(nullptr) {}
 
     void enqueue(BookingRequest *request)
     {
+        lock_guard<mutex> guard(viewLock);
         if (!rear)
         {
             front = rear = request;
@@ -95,6 +215,7 @@ struct BookingQueue
 
     BookingRequest *dequeue()
     {
+        lock_guard<mutex> guard(viewLock);
         if (!front)
             return nullptr;
         BookingRequest *request = front;
@@ -108,607 +229,3847 @@ struct BookingQueue
     {
         return front == nullptr;
     }
+
+    // Copy of the waiting requests, safe to read from another thread
+    vector<BookingRequest> snapshot()
+    {
+        lock_guard<mutex> guard(viewLock);
+        vector<BookingRequest> requests;
+        for (BookingRequest *current = front; current; current = current->next)
+        {
+            requests.push_back(*current);
+            requests.back().next = nullptr;
+        }
+        return requests;
+    }
 };
 
-// Custom Stack Implementation
-struct BookingStack
+// Read-only view of the booking history at one moment. Chunks and name pages
+// are shared with the live store, which copies a page before changing it.
+struct HistorySnapshot
 {
-    BookingHistory *top;
-
-    BookingStack() : top(nullptr) {}
+    vector<shared_ptr<const HistoryChunk>> chunks;
+    vector<shared_ptr<const NamePage>> namePages;
+    int baseIndex;
+    int total;
 
-    void push(BookingHistory *history)
+    const HistoryChunk &chunkFor(int index) const
     {
-        history->next = top;
-        top = history;
+        return *chunks[(index - baseIndex) / HISTORY_CHUNK_SIZE];
     }
 
-    BookingHistory *pop()
+    // Materialise record number index (0 is the oldest)
+    BookingHistory get(int index) const
     {
-        if (!top)
-            return nullptr;
-        BookingHistory *history = top;
-        top = top->next;
-        return history;
+        const HistoryChunk &chunk = chunkFor(index);
+        int i = (index - baseIndex) % HISTORY_CHUNK_SIZE;
+        return BookingHistory{
+            namePages[chunk.customerId[i] / NAME_PAGE_SIZE]->names[chunk.customerId[i] % NAME_PAGE_SIZE],
+            (Room::RoomType)chunk.roomType[i],
+            chunk.roomId[i],
+            chunk.nights[i],
+            chunk.checkInDay[i],
+            chunk.groupId[i],
+            chunk.bookedAt[i]};
     }
 
-    bool isEmpty()
+    bool isArchived(int index) const
     {
-        return top == nullptr;
+        return chunkFor(index).archived[(index - baseIndex) % HISTORY_CHUNK_SIZE];
     }
 
-    void display()
+    // Visit every active record for a room, newest first
+    template <typename Visitor>
+    void forEachInRoom(int roomId, Visitor visit) const
     {
-        cout << "\n--- Booking History ---\n";
-        cout << left << setw(20) << "Customer Name"
-             << setw(10) << "Room ID"
-             << setw(15) << "Room Type"
-             << setw(10) << "Nights" << endl;
-
-        cout << setfill('-') << setw(70) << "" << setfill(' ') << endl; // Separator line
-
-        BookingHistory *current = top;
-        if (!current)
-        {
-            cout << "No bookings in the history.\n";
-            return;
-        }
-        while (current)
+        for (int c = (int)chunks.size() - 1; c >= 0; c--)
         {
-            cout << left << setw(20) << current->customerName
-                 << setw(10) << current->roomId
-                 << setw(15) << (current->roomType == Room::SINGLE ? "Single" : current->roomType == Room::DOUBLE ? "Double"
-                                                                                                                  : "Suite")
-                 << setw(10) << current->nights << "\n";
-            current = current->next;
+            const HistoryChunk &chunk = *chunks[c];
+            if (roomId < chunk.minRoomId || roomId > chunk.maxRoomId || chunk.archivedCount == chunk.count)
+                continue;
+            for (int i = chunk.count - 1; i >= 0; i--)
+            {
+                if (chunk.roomId[i] == roomId && !chunk.archived[i])
+                    visit(baseIndex + c * HISTORY_CHUNK_SIZE + i);
+            }
         }
     }
-};
-
-// Hotel Management System Class
-class HotelManagementSystem
-{
-private:
-    TreeNode *root;             // Tree root for hotel floors and rooms
-    BookingQueue regularQueue;  // Regular booking queue
-    BookingQueue priorityQueue; // Priority booking queue
-    BookingStack historyStack;  // Stack for booking history
 
-    // Helper function to insert room into the tree
-    TreeNode *insertRoom(TreeNode *node, TreeNode *newNode)
+    // Visit every active record whose stay overlaps days [fromDay, toDay), newest first
+    template <typename Visitor>
+    void forEachInRange(int fromDay, int toDay, Visitor visit) const
     {
-        if (!node)
-            return newNode;
-        if (newNode->room->id < node->room->id)
-        {
-            node->left = insertRoom(node->left, newNode);
-            node->left->parent = node;
-        }
-        else
+        for (int c = (int)chunks.size() - 1; c >= 0; c--)
         {
-            node->right = insertRoom(node->right, newNode);
-            node->right->parent = node;
+            const HistoryChunk &chunk = *chunks[c];
+            if (chunk.maxCheckOut <= fromDay || chunk.minCheckIn >= toDay || chunk.archivedCount == chunk.count)
+                continue;
+            for (int i = chunk.count - 1; i >= 0; i--)
+            {
+                if (chunk.checkInDay[i] < toDay && chunk.checkInDay[i] + chunk.nights[i] > fromDay &&
+                    !chunk.archived[i])
+                    visit(baseIndex + c * HISTORY_CHUNK_SIZE + i);
+            }
         }
-        return node;
     }
 
-    // Cleanup function for tree
-    void cleanupTree(TreeNode *node)
+    static void displayHeader()
     {
-        if (!node)
-            return;
-        cleanupTree(node->left);
-        cleanupTree(node->right);
-        delete node->room;
-        delete node;
+        cout << left << setw(20) << "Customer Name"
+             << setw(10) << "Room ID"
+             << setw(15) << "Room Type"
+             << setw(10) << "Check-In"
+             << setw(10) << "Nights"
+             << setw(10) << "Group" << endl;
+
+        cout << setfill('-') << setw(75) << "" << setfill(' ') << endl; // Separator line
     }
 
-    // Updated function to check room availability for specific dates
-    bool isRoomAvailable(Room *room, int checkInDay, int nights)
+    void displayRecord(int index) const
     {
-        if (checkInDay + nights > MAX_DAYS)
-            return false;
+        BookingHistory current = get(index);
+        cout << left << setw(20) << current.customerName
+             << setw(10) << current.roomId
+             << setw(15) << ROOM_TYPE_LABELS[current.roomType]
+             << setw(10) << current.checkInDay
+             << setw(10) << current.nights;
+        if (current.groupId)
+            cout << setw(10) << current.groupId;
+        else
+            cout << setw(10) << "-";
+        cout << "\n";
+    }
 
-        for (int i = checkInDay; i < checkInDay + nights; i++)
+    void display(const string &title) const
+    {
+        cout << "\n--- " << title << " ---\n";
+        displayHeader();
+
+        int shown = 0;
+        for (int index = total - 1; index >= baseIndex; index--)
         {
-            if (!room->availabilityCalendar[i])
-                return false;
+            if (isArchived(index))
+                continue;
+            displayRecord(index);
+            ++shown;
         }
-        return true;
+        if (shown == 0)
+            cout << "No bookings in the history.\n";
     }
+};
+
+// Custom Stack Implementation
+// Append-only columnar store; push and pop work on the newest record.
+// Record indices never change: compaction drops whole chunks from the front
+// and advances baseIndex instead of renumbering.
+// One thread changes the store; any thread may take a snapshot(). Changes are
+// made under viewLock and copy a chunk or name page first if a snapshot may hold it.
+struct BookingStack
+{
+    deque<shared_ptr<HistoryChunk>> chunks;
+    vector<shared_ptr<NamePage>> namePages;
+    int baseIndex; // Index of the first record in chunks.front()
+    int total;     // Index the next pushed record will get
 
+    // Customer names are stored once and referenced by id
+    unordered_map<string, int> customerIds;
+    int customerCount;
+    chrono::steady_clock::time_point createdAt;
+    mutex viewLock;
+    long long snapshotEpoch; // Snapshots taken so far
 
-    // Display room status (in-order traversal)
+    BookingStack() : baseIndex(0), total(0), customerCount(0), createdAt(chrono::steady_clock::now()), snapshotEpoch(0) {}
 
-    void displayRoomStatusHelper(TreeNode *node)
+    // Chunk c, copied first if a snapshot may share it. Call with viewLock held.
+    HistoryChunk *mutableChunk(int c)
     {
-        if (!node)
-            return;
+        return writablePage(chunks[c], snapshotEpoch);
+    }
 
-        displayRoomStatusHelper(node->left);
+    int internCustomer(const string &customerName)
+    {
+        unordered_map<string, int>::iterator found = customerIds.find(customerName);
+        if (found != customerIds.end())
+            return found->second;
 
-        cout << left << setw(10) << node->room->id
-             << setw(15) << (node->room->type == Room::SINGLE ? "Single" : node->room->type == Room::DOUBLE ? "Double"
-                                                                                                            : "Suite")
-             << setw(15) << node->room->floorNumber
-             << setw(15) << (node->room->status == Room::OCCUPIED ? "Occupied" : node->room->status == Room::BOOKED ? "Booked"
-                                                                             : node->room->status == Room::READY    ? "Ready"
-                                                                                                                    : "Unavailable")
-             << endl;
+        if (namePages.empty() || namePages.back()->count == NAME_PAGE_SIZE)
+            namePages.push_back(make_shared<NamePage>(snapshotEpoch));
 
-        displayRoomStatusHelper(node->right);
+        NamePage *page = writablePage(namePages.back(), snapshotEpoch);
+        page->names[page->count++] = customerName;
+        customerIds[customerName] = customerCount;
+        return customerCount++;
     }
-    // Process a single booking request
-    void processSingleRequest(BookingRequest *request)
+
+    // Add a record stamped with the current time. Returns the index of the new record.
+    int push(const BookingHistory &history)
     {
-        TreeNode *availableRoom = findAvailableRoomOnFloor(root, request->requestedType,
-                                                           request->floornum, request->checkInDay,
-                                                           request->nights);
+        BookingHistory stamped = history;
+        stamped.bookedAt = chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now() - createdAt).count();
+        return append(stamped);
+    }
 
-        if (availableRoom)
+    // Add a record that keeps its own bookedAt, e.g. one moved from another store.
+    // Returns the index of the new record.
+    int append(const BookingHistory &history)
+    {
+        lock_guard<mutex> guard(viewLock);
+        if (chunks.empty() || chunks.back()->count == HISTORY_CHUNK_SIZE)
         {
-            // Mark room as booked for the specified dates
-            for (int i = request->checkInDay; i < request->checkInDay + request->nights; i++)
-            {
-                availableRoom->room->availabilityCalendar[i] = false;
-            }
-            availableRoom->room->status = Room::BOOKED;
+            chunks.push_back(make_shared<HistoryChunk>(snapshotEpoch));
+        }
 
-            // Create booking history record
-            BookingHistory *history = new BookingHistory{
-                request->customerName,
-                request->requestedType,
-                availableRoom->room->id,
-                request->nights,
-                nullptr};
-            historyStack.push(history);
+        int customerId = internCustomer(history.customerName);
+        HistoryChunk *chunk = mutableChunk(chunks.size() - 1);
+        int i = chunk->count;
+        chunk->customerId[i] = customerId;
+        chunk->roomId[i] = history.roomId;
+        chunk->groupId[i] = history.groupId;
+        chunk->bookedAt[i] = history.bookedAt;
+        chunk->checkInDay[i] = history.checkInDay;
+        chunk->nights[i] = history.nights;
+        chunk->roomType[i] = history.roomType;
+        chunk->archived[i] = 0;
 
-            cout << "Booking confirmed for " << request->customerName
-                 << "\nRoom ID: " << availableRoom->room->id
-                 << "\nFloor: " << availableRoom->room->floorNumber
-                 << "\nCheck-in Day: " << request->checkInDay
-                 << "\nNights: " << request->nights << endl;
+        int checkOut = history.checkInDay + history.nights;
+        if (i == 0)
+        {
+            chunk->minRoomId = chunk->maxRoomId = history.roomId;
+            chunk->minCheckIn = history.checkInDay;
+            chunk->maxCheckOut = checkOut;
         }
         else
         {
-            cout << "No available room found for " << request->customerName
-                 << " on floor " << request->floornum << endl;
+            chunk->minRoomId = min(chunk->minRoomId, history.roomId);
+            chunk->maxRoomId = max(chunk->maxRoomId, history.roomId);
+            chunk->minCheckIn = min(chunk->minCheckIn, history.checkInDay);
+            chunk->maxCheckOut = max(chunk->maxCheckOut, checkOut);
         }
-        delete request;
+
+        ++chunk->count;
+        return total++;
     }
-    // Cancel most recent booking
-    void cancelMostRecentBooking()
-    {
-        if (historyStack.isEmpty())
-        {
-            cout << "No bookings to cancel.\n";
-            return;
-        }
 
-        BookingHistory *history = historyStack.pop();
-        TreeNode *roomNode = findRoomById(root, history->roomId);
+    // Remove the newest record, copying it into history
+    bool pop(BookingHistory &history)
+    {
+        if (isEmpty())
+            return false;
+        history = get(total - 1);
 
-        if (roomNode)
+        lock_guard<mutex> guard(viewLock);
+        HistoryChunk *chunk = mutableChunk(chunks.size() - 1);
+        if (chunk->archived[chunk->count - 1])
+            --chunk->archivedCount;
+        if (--chunk->count == 0)
         {
-            // Mark room as available for the specified dates
-            for (int i = 0; i < history->nights; i++)
-            {
-                roomNode->room->availabilityCalendar[i] = true;
-            }
-            roomNode->room->status = Room::READY;
-
-            cout << "Cancelled booking for customer: " << history->customerName
-                 << ", Room ID: " << history->roomId << ", Nights: " << history->nights << "\n";
+            chunks.pop_back();
         }
-
-        delete history;
+        --total;
+        return true;
     }
 
-    // Helper function to find a room by ID
-    TreeNode *findRoomById(TreeNode *node, int roomId)
+    BookingHistory peek()
     {
-        if (!node)
-            return nullptr;
-        if (node->room->id == roomId)
-            return node;
-        TreeNode *leftSearch = findRoomById(node->left, roomId);
-        if (leftSearch)
-            return leftSearch;
-        return findRoomById(node->right, roomId);
+        return get(total - 1);
     }
 
-    void displayRoomsByFloorHelper(TreeNode *node, int floorNumber)
+    // Materialise record number index (0 is the oldest)
+    BookingHistory get(int index)
     {
-        if (!node)
-            return;
+        HistoryChunk *chunk = chunks[(index - baseIndex) / HISTORY_CHUNK_SIZE].get();
+        int i = (index - baseIndex) % HISTORY_CHUNK_SIZE;
+        return BookingHistory{
+            namePages[chunk->customerId[i] / NAME_PAGE_SIZE]->names[chunk->customerId[i] % NAME_PAGE_SIZE],
+            (Room::RoomType)chunk->roomType[i],
+            chunk->roomId[i],
+            chunk->nights[i],
+            chunk->checkInDay[i],
+            chunk->groupId[i],
+            chunk->bookedAt[i]};
+    }
 
-        displayRoomsByFloorHelper(node->left, floorNumber);
+    bool contains(int index)
+    {
+        return index >= baseIndex && index < total;
+    }
 
-        if (node->room->floorNumber == floorNumber)
-        {
-            cout << "Room ID: " << node->room->id
-                 << ", Type: " << (node->room->type == Room::SINGLE ? "Single" : node->room->type == Room::DOUBLE ? "Double"
-                                                                                                                  : "Suite")
-                 << ", Status: ";
-            switch (node->room->status)
-            {
-            case Room::OCCUPIED:
-                cout << "Occupied";
-                break;
-            case Room::BOOKED:
-                cout << "Booked";
-                break;
-            case Room::READY:
-                cout << "Ready";
-                break;
-            default:
-                cout << "Unavailable";
-                break;
-            }
-            cout << "\n";
-        }
+    // Shorten a stay after an early checkout
+    void setNights(int index, int nights)
+    {
+        lock_guard<mutex> guard(viewLock);
+        mutableChunk((index - baseIndex) / HISTORY_CHUNK_SIZE)->nights[(index - baseIndex) % HISTORY_CHUNK_SIZE] = nights;
+    }
 
-        displayRoomsByFloorHelper(node->right, floorNumber);
+    bool isArchived(int index)
+    {
+        return chunks[(index - baseIndex) / HISTORY_CHUNK_SIZE]->archived[(index - baseIndex) % HISTORY_CHUNK_SIZE];
     }
-    TreeNode *findAvailableRoomOnFloor(TreeNode *node, Room::RoomType type, int floorNumber, int checkInDay, int nights)
+
+    // Mark a finished stay; it is skipped by lookups and freed by compact()
+    void markArchived(int index)
     {
-        if (!node)
-            return nullptr;
+        if (isArchived(index))
+            return;
 
+        lock_guard<mutex> guard(viewLock);
+        HistoryChunk *chunk = mutableChunk((index - baseIndex) / HISTORY_CHUNK_SIZE);
+        chunk->archived[(index - baseIndex) % HISTORY_CHUNK_SIZE] = 1;
+        ++chunk->archivedCount;
+    }
 
-        // Check if the room is on the specified floor and matches the requested type
-        if (node->room->floorNumber == floorNumber && node->room->type == type &&
-            node->room->status == Room::READY && isRoomAvailable(node->room, checkInDay, nights))
+    // Free full chunks at the front whose records have all been archived.
+    // Returns the number of records released.
+    int compact()
+    {
+        lock_guard<mutex> guard(viewLock);
+        int released = 0;
+        while (chunks.size() > 1 && chunks.front()->archivedCount == HISTORY_CHUNK_SIZE)
         {
-            return node;
+            chunks.pop_front();
+            baseIndex += HISTORY_CHUNK_SIZE;
+            released += HISTORY_CHUNK_SIZE;
         }
+        return released;
+    }
 
-        // Search left and right subtrees
-        TreeNode *leftSearch = findAvailableRoomOnFloor(node->left, type, floorNumber, checkInDay, nights);
-        if (leftSearch)
-            return leftSearch;
+    bool isEmpty()
+    {
+        return total == baseIndex;
+    }
 
-        return findAvailableRoomOnFloor(node->right, type, floorNumber, checkInDay, nights);
+    int size()
+    {
+        return total;
     }
 
-public:
-    // Constructor
-    HotelManagementSystem(int floors, int roomsPerFloor)
-        : root(nullptr)
+    // Index of the most recent active record for a customer, or -1
+    int findLatest(const string &customerName)
     {
-        int idCounter = 1;
+        unordered_map<string, int>::iterator found = customerIds.find(customerName);
+        if (found == customerIds.end())
+            return -1;
 
-        for (int floor = 1; floor <= floors; ++floor)
+        for (int c = (int)chunks.size() - 1; c >= 0; c--)
         {
-            // Ensure even distribution of room types per floor
-            int singlesPerFloor = roomsPerFloor / 3;
-            int doublesPerFloor = roomsPerFloor / 3;
-            int suitesPerFloor = roomsPerFloor - singlesPerFloor - doublesPerFloor;
-
-            // Create single rooms
-            for (int i = 0; i < singlesPerFloor; ++i)
-            {
-                Room *newRoom = new Room(idCounter++, Room::SINGLE, Room::READY, floor);
-                TreeNode *newNode = new TreeNode(newRoom);
-                root = insertRoom(root, newNode);
-            }
-
-            // Create double rooms
-            for (int i = 0; i < doublesPerFloor; ++i)
-            {
-                Room *newRoom = new Room(idCounter++, Room::DOUBLE, Room::READY, floor);
-                TreeNode *newNode = new TreeNode(newRoom);
-                root = insertRoom(root, newNode);
-            }
-
-            // Create suites
-            for (int i = 0; i < suitesPerFloor; ++i)
+            for (int i = chunks[c]->count - 1; i >= 0; i--)
             {
-                Room *newRoom = new Room(idCounter++, Room::SUITE, Room::READY, floor);
-                TreeNode *newNode = new TreeNode(newRoom);
-                root = insertRoom(root, newNode);
+                if (chunks[c]->customerId[i] == found->second && !chunks[c]->archived[i])
+                    return baseIndex + c * HISTORY_CHUNK_SIZE + i;
             }
         }
+        return -1;
     }
-    void displayRoomsByFloor(int floorNumber)
+
+    // Cheap read-only view: copies the page tables, not the records
+    HistorySnapshot snapshot()
     {
-        cout << "\nRooms on Floor " << floorNumber << ":\n";
-        displayRoomsByFloorHelper(root, floorNumber);
+        lock_guard<mutex> guard(viewLock);
+        ++snapshotEpoch;
+        HistorySnapshot view;
+        view.chunks.assign(chunks.begin(), chunks.end());
+        view.namePages.assign(namePages.begin(), namePages.end());
+        view.baseIndex = baseIndex;
+        view.total = total;
+        return view;
     }
+};
 
-    // Destructor
-    ~HotelManagementSystem()
+// Custom Room Index Implementation
+// Rooms stored in id order, which the constructor lays out floor by floor and
+// type by type, so every (floor, type) group is one contiguous range.
+struct RoomIndex
+{
+    int floors;
+    Room **rooms;
+    int *offsets; // Group (floor, type) spans [offsets[g], offsets[g + 1])
+
+    RoomIndex(int floors, int roomsPerFloor) : floors(floors)
     {
-        cleanupTree(root);
-        while (historyStack.top)
+        rooms = new Room *[floors * roomsPerFloor];
+        offsets = new int[floors * 3 + 1];
+        for (int i = 0; i <= floors * 3; i++)
         {
-            delete historyStack.pop();
+            offsets[i] = 0;
         }
     }
 
-    // Make a booking request
+    ~RoomIndex()
+    {
+        delete[] rooms;
+        delete[] offsets;
+    }
 
-    void makeBookingRequest(string name, Room::RoomType type, int nights,
-                            int checkInDay, bool isPriority, int floorNumber)
+    // Rooms must be added in id order
+    void add(Room *room)
     {
-        // Input validation
-        if (checkInDay < 0 || checkInDay >= MAX_DAYS || nights <= 0 ||
-            checkInDay + nights > MAX_DAYS || floorNumber < 1 || floorNumber > 5)
+        int group = (room->floorNumber - 1) * 3 + room->type;
+        rooms[offsets[floors * 3]] = room;
+        for (int g = group + 1; g <= floors * 3; g++)
         {
-            cout << "Invalid booking parameters!\n";
-            return;
+            offsets[g]++;
         }
+    }
 
-        cout << "\nChecking availability for:\n"
-             << "Customer: " << name << "\n"
-             << "Floor: " << floorNumber << "\n"
-             << "Room Type: " << (type == Room::SINGLE ? "Single" : type == Room::DOUBLE ? "Double"
-                                                                                         : "Suite")
-             << "\n"
-             << "Check-in Day: " << checkInDay << "\n"
-             << "Nights: " << nights << "\n";
+    Room **begin(int floor, Room::RoomType type)
+    {
+        return rooms + offsets[(floor - 1) * 3 + type];
+    }
 
-        // First check if there's an available room of the requested type on the specified floor
-        TreeNode *availableRoom = findAvailableRoomOnFloor(root, type, floorNumber, checkInDay, nights);
+    Room **end(int floor, Room::RoomType type)
+    {
+        return rooms + offsets[(floor - 1) * 3 + type + 1];
+    }
 
-        if (availableRoom)
-        {
-            // Room is available, create the booking request
-            BookingRequest *request = new BookingRequest{
-                name, type, nights, floorNumber, checkInDay, isPriority, nullptr};
+    // Ids start at 1 and are assigned in the same order rooms are added
+    Room *byId(int roomId)
+    {
+        return roomId >= 1 && roomId <= size() ? rooms[roomId - 1] : nullptr;
+    }
 
-            // Add to appropriate queue
-            if (isPriority)
-            {
-                priorityQueue.enqueue(request);
-                cout << "High-priority booking request added successfully.\n";
-            }
-            else
-            {
-                regularQueue.enqueue(request);
-                cout << "Regular booking request added successfully.\n";
-            }
+    int size()
+    {
+        return offsets[floors * 3];
+    }
+};
+
+// Read-only view of every room at one version, in id order
+struct RoomSnapshot
+{
+    vector<shared_ptr<const RoomPage>> pages;
+    long long version;
+    int currentDay;
+    int size;
+
+    const Room &room(int slot) const
+    {
+        return pages[slot / ROOM_PAGE_SIZE]->rooms[slot % ROOM_PAGE_SIZE];
+    }
+};
+
+// Copy-on-write page table of room copies, kept in step with the live rooms so
+// that reports can run on another thread without stopping bookings
+struct RoomPageTable
+{
+    vector<shared_ptr<RoomPage>> pages;
+    int size;
+    long long version;
+    int currentDay; // Hotel day the published rooms belong to
+    mutex viewLock;
+    long long snapshotEpoch; // Snapshots taken so far
+
+    RoomPageTable() : size(0), version(0), currentDay(0), snapshotEpoch(0) {}
+
+    // Rooms must be added in id order
+    void add(const Room *room)
+    {
+        if (size % ROOM_PAGE_SIZE == 0)
+            pages.push_back(make_shared<RoomPage>(snapshotEpoch));
+        pages.back()->rooms.push_back(*room);
+        ++size;
+    }
+
+    // Copy a changed room into its page, copying the page first if a snapshot may hold it
+    void publish(const Room *room)
+    {
+        int slot = room->id - 1;
+        lock_guard<mutex> guard(viewLock);
+        RoomPage *page = writablePage(pages[slot / ROOM_PAGE_SIZE], snapshotEpoch);
+        page->rooms[slot % ROOM_PAGE_SIZE] = *room;
+        ++version;
+    }
+
+    void setDay(int day)
+    {
+        lock_guard<mutex> guard(viewLock);
+        currentDay = day;
+        ++version;
+    }
+
+    RoomSnapshot snapshot()
+    {
+        lock_guard<mutex> guard(viewLock);
+        ++snapshotEpoch;
+        RoomSnapshot view;
+        view.pages.assign(pages.begin(), pages.end());
+        view.version = version;
+        view.currentDay = currentDay;
+        view.size = size;
+        return view;
+    }
+};
+
+// Work-Stealing Thread Pool
+// Runs a job split into numbered chunks. A task covers a range of chunks; the
+// thread running it keeps splitting off the upper half onto its own queue until
+// one chunk is left. Idle threads steal from the front of other queues, which
+// holds the largest ranges. The thread that submits a job works on it too.
+// Results are stored per chunk and merged in chunk order, so the output does
+// not depend on the number of threads or on who ran what.
+class WorkStealingPool
+{
+private:
+    struct Job
+    {
+        const function<void(int)> *body;
+        atomic<int> remaining; // Chunks not yet finished
+    };
+
+    struct Task
+    {
+        Job *job;
+        int first, last; // Chunks [first, last)
+    };
+
+    struct TaskQueue
+    {
+        mutex lock;
+        deque<Task> tasks;
+    };
+
+    vector<unique_ptr<TaskQueue>> queues; // One per worker, the last for the submitting thread
+    vector<thread> workers;
+    mutex sleepLock;
+    condition_variable wake;
+    atomic<int> queued;
+    atomic<bool> stopping;
+    mutex submitLock; // One job at a time
+
+    void push(int self, const Task &task)
+    {
+        {
+            lock_guard<mutex> guard(queues[self]->lock);
+            queues[self]->tasks.push_back(task);
+        }
+        ++queued;
+        {
+            lock_guard<mutex> guard(sleepLock);
+        }
+        wake.notify_one();
+    }
+
+    // Newest task from our own queue, otherwise the oldest one from another queue
+    bool take(int self, Task &task)
+    {
+        int count = queues.size();
+        for (int i = 0; i < count; i++)
+        {
+            TaskQueue &queue = *queues[(self + i) % count];
+            lock_guard<mutex> guard(queue.lock);
+            if (queue.tasks.empty())
+                continue;
+            if (i == 0)
+            {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            --queued;
+            return true;
+        }
+        return false;
+    }
+
+    void run(int self, Task task)
+    {
+        while (task.last - task.first > 1)
+        {
+            int middle = task.first + (task.last - task.first) / 2;
+            push(self, Task{task.job, middle, task.last});
+            task.last = middle;
+        }
+        (*task.job->body)(task.first);
+        --task.job->remaining;
+    }
+
+    void workerLoop(int self)
+    {
+        Task task;
+        while (true)
+        {
+            if (take(self, task))
+            {
+                run(self, task);
+                continue;
+            }
+
+            unique_lock<mutex> guard(sleepLock);
+            wake.wait(guard, [this]()
+                      { return queued > 0 || stopping; });
+            if (stopping)
+                return;
+        }
+    }
+
+public:
+    // threads counts the submitting thread, so 1 runs everything inline
+    explicit WorkStealingPool(int threads) : queued(0), stopping(false)
+    {
+        threads = max(threads, 1);
+        for (int i = 0; i < threads; i++)
+            queues.push_back(unique_ptr<TaskQueue>(new TaskQueue()));
+        for (int i = 0; i < threads - 1; i++)
+            workers.push_back(thread(&WorkStealingPool::workerLoop, this, i));
+    }
+
+    ~WorkStealingPool()
+    {
+        {
+            lock_guard<mutex> guard(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread &worker : workers)
+            worker.join();
+    }
+
+    int size()
+    {
+        return queues.size();
+    }
+
+    // Run body(chunk) for every chunk in [0, chunks) and wait for all of them
+    void forEachChunk(int chunks, const function<void(int)> &body)
+    {
+        if (chunks <= 0)
+            return;
+
+        lock_guard<mutex> submit(submitLock);
+        int self = queues.size() - 1;
+        Job job;
+        job.body = &body;
+        job.remaining = chunks;
+        run(self, Task{&job, 0, chunks});
+
+        Task task;
+        while (job.remaining > 0)
+        {
+            if (take(self, task))
+                run(self, task);
+            else
+                this_thread::yield();
+        }
+    }
+
+    // map(chunk) gives each chunk's result; they are merged in chunk order
+    template <typename Result, typename Map, typename Merge>
+    Result mapChunks(int chunks, Map map, Merge merge)
+    {
+        vector<Result> partial(max(chunks, 0));
+        forEachChunk(chunks, [&](int chunk)
+                     { partial[chunk] = map(chunk); });
+
+        Result total = Result();
+        for (int chunk = 0; chunk < chunks; chunk++)
+            merge(total, partial[chunk]);
+        return total;
+    }
+};
+
+// Define OccupancySummary structure (totals from a full-inventory sweep)
+struct OccupancySummary
+{
+    int rooms;
+    int byStatus[4];    // Indexed by Room::Status
+    int byType[3];      // Indexed by Room::RoomType
+    int freeByType[3];  // Rooms of each type free for the whole window
+    long long freeNights;
+    long long bookedNights;
+
+    OccupancySummary() : rooms(0), byStatus(), byType(), freeByType(), freeNights(0), bookedNights(0) {}
+
+    void add(const OccupancySummary &other)
+    {
+        rooms += other.rooms;
+        for (int i = 0; i < 4; i++)
+            byStatus[i] += other.byStatus[i];
+        for (int i = 0; i < 3; i++)
+        {
+            byType[i] += other.byType[i];
+            freeByType[i] += other.freeByType[i];
+        }
+        freeNights += other.freeNights;
+        bookedNights += other.bookedNights;
+    }
+
+    bool operator==(const OccupancySummary &other) const
+    {
+        return rooms == other.rooms && equal(byStatus, byStatus + 4, other.byStatus) &&
+               equal(byType, byType + 3, other.byType) && equal(freeByType, freeByType + 3, other.freeByType) &&
+               freeNights == other.freeNights && bookedNights == other.bookedNights;
+    }
+};
+
+// Full-inventory scans. Each chunk is one room page of the snapshot.
+
+// Room counts and booked nights over days [fromDay, toDay), which must lie in
+// the snapshot's bookable window
+OccupancySummary summarizeOccupancy(WorkStealingPool &pool, const RoomSnapshot &rooms, int fromDay, int toDay)
+{
+    return pool.mapChunks<OccupancySummary>(
+        rooms.pages.size(),
+        [&](int chunk)
+        {
+            OccupancySummary summary;
+            const vector<Room> &page = rooms.pages[chunk]->rooms;
+            for (const Room &room : page)
+            {
+                int free = 0;
+                for (int day = fromDay; day < toDay; day++)
+                    free += room.availabilityCalendar[day % MAX_DAYS];
+
+                ++summary.rooms;
+                ++summary.byStatus[room.status];
+                ++summary.byType[room.type];
+                if (room.status != Room::UNAVAILABLE)
+                {
+                    summary.freeNights += free;
+                    summary.bookedNights += (toDay - fromDay) - free;
+                    if (free == toDay - fromDay)
+                        ++summary.freeByType[room.type];
+                }
+            }
+            return summary;
+        },
+        [](OccupancySummary &total, const OccupancySummary &part)
+        { total.add(part); });
+}
+
+// Ids of bookable rooms free for the whole stay, in id order.
+// floorNumber 0 and roomType -1 match any.
+vector<int> findFreeRoomIds(WorkStealingPool &pool, const RoomSnapshot &rooms, int roomType, int floorNumber,
+                            int checkInDay, int nights)
+{
+    return pool.mapChunks<vector<int>>(
+        rooms.pages.size(),
+        [&](int chunk)
+        {
+            vector<int> ids;
+            for (const Room &room : rooms.pages[chunk]->rooms)
+            {
+                if (room.status == Room::UNAVAILABLE || (roomType >= 0 && room.type != roomType) ||
+                    (floorNumber != 0 && room.floorNumber != floorNumber))
+                    continue;
+
+                bool free = true;
+                for (int day = checkInDay; day < checkInDay + nights && free; day++)
+                    free = room.availabilityCalendar[day % MAX_DAYS];
+                if (free)
+                    ids.push_back(room.id);
+            }
+            return ids;
+        },
+        [](vector<int> &total, const vector<int> &part)
+        { total.insert(total.end(), part.begin(), part.end()); });
+}
+
+// Report Layer
+// Reports format rows into one reusable buffer and write it out in large
+// blocks, instead of going through iostream formatting for every field.
+enum ReportFormat
+{
+    REPORT_TABLE,
+    REPORT_CSV,
+    REPORT_JSON // JSON Lines: one object per row, so pages can be joined as they are
+};
+
+const int REPORT_BUFFER_SIZE = 64 * 1024; // Bytes buffered before a report writes them out
+
+// Define ReportColumn structure
+struct ReportColumn
+{
+    const char *title; // Table and CSV header
+    const char *key;   // JSON field name
+    int width;         // Table column width
+};
+
+// Define ReportQuery structure (filters and the paging cursor for one report)
+struct ReportQuery
+{
+    ReportFormat format;
+    int pageSize; // Rows per page, 0 for everything
+    int cursor;   // Where the next page starts, -1 before the first page
+    bool done;    // Set once the last page has been written
+    string buffer; // Reused by every page of the report
+
+    // Filters; a field left at its default matches everything
+    int floorNumber;     // 0 = any floor
+    int roomType;        // -1 = any type
+    int status;          // -1 = any status (rooms)
+    int roomId;          // 0 = any room (history)
+    int fromDay, toDay;  // Stay overlaps [fromDay, toDay) (history, requests)
+    string customerName; // Empty = any customer (history, requests)
+
+    ReportQuery(ReportFormat format = REPORT_TABLE, int pageSize = 0)
+        : format(format), pageSize(pageSize), cursor(-1), done(false),
+          floorNumber(0), roomType(-1), status(-1), roomId(0),
+          fromDay(numeric_limits<int>::min()), toDay(numeric_limits<int>::max()) {}
+
+    bool pageFull(int rows) const
+    {
+        return pageSize > 0 && rows >= pageSize;
+    }
+};
+
+// Writes one page of rows in the query's format. Fields are copied straight
+// into the buffer; it is written out whenever the next field would not fit.
+struct ReportWriter
+{
+    ostream &out;
+    ReportFormat format;
+    const ReportColumn *columns;
+    int columnCount;
+    string &buffer;
+    char *put;   // Next free byte in buffer
+    char *limit; // End of buffer
+    int column;  // Next column in the current row
+    int rows;
+
+    ReportWriter(ostream &out, ReportQuery &query, const ReportColumn *columns, int columnCount)
+        : out(out), format(query.format), columns(columns), columnCount(columnCount),
+          buffer(query.buffer), column(0), rows(0)
+    {
+        if (buffer.size() < (size_t)REPORT_BUFFER_SIZE)
+            buffer.resize(REPORT_BUFFER_SIZE);
+        put = &buffer[0];
+        limit = put + buffer.size();
+
+        // CSV has one header for the whole report; tables repeat it per page
+        if (format == REPORT_TABLE)
+        {
+            int totalWidth = 0;
+            for (int i = 0; i < columnCount; i++)
+            {
+                appendPadded(columns[i].title, strlen(columns[i].title), columns[i].width);
+                totalWidth += columns[i].width;
+            }
+            append("\n", 1);
+            reserve(totalWidth + 1);
+            memset(put, '-', totalWidth);
+            put += totalWidth;
+            *put++ = '\n';
+        }
+        else if (format == REPORT_CSV && query.cursor == -1)
+        {
+            for (int i = 0; i < columnCount; i++)
+            {
+                if (i > 0)
+                    append(",", 1);
+                append(columns[i].title, strlen(columns[i].title));
+            }
+            append("\n", 1);
+        }
+    }
+
+    // Make room for length more bytes
+    void reserve(size_t length)
+    {
+        if ((size_t)(limit - put) >= length)
+            return;
+        flush();
+        if (buffer.size() < length)
+        {
+            buffer.resize(length);
+            put = &buffer[0];
+            limit = put + buffer.size();
+        }
+    }
+
+    void append(const char *value, size_t length)
+    {
+        reserve(length);
+        memcpy(put, value, length);
+        put += length;
+    }
+
+    void appendPadded(const char *value, size_t length, int width)
+    {
+        size_t padding = (int)length < width ? width - length : 0;
+        reserve(length + padding);
+        memcpy(put, value, length);
+        memset(put + length, ' ', padding);
+        put += length + padding;
+    }
+
+    // Start a field: separators and the JSON key
+    void beginField()
+    {
+        if (format == REPORT_CSV && column > 0)
+        {
+            append(",", 1);
+        }
+        else if (format == REPORT_JSON)
+        {
+            if (column == 0)
+                append("{\"", 2);
+            else
+                append(",\"", 2);
+            append(columns[column].key, strlen(columns[column].key));
+            append("\":", 2);
+        }
+    }
+
+    void text(const char *value, size_t length)
+    {
+        beginField();
+        if (format == REPORT_TABLE)
+        {
+            appendPadded(value, length, columns[column].width);
+        }
+        else if (format == REPORT_CSV)
+        {
+            if (find_first_of(value, value + length, ",\"\r\n", ",\"\r\n" + 4) == value + length)
+            {
+                append(value, length);
+            }
+            else
+            {
+                reserve(length * 2 + 2);
+                *put++ = '"';
+                for (size_t i = 0; i < length; i++)
+                {
+                    if (value[i] == '"')
+                        *put++ = '"';
+                    *put++ = value[i];
+                }
+                *put++ = '"';
+            }
+        }
+        else
+        {
+            reserve(length * 6 + 2);
+            *put++ = '"';
+            for (size_t i = 0; i < length; i++)
+            {
+                char c = value[i];
+                if (c == '"' || c == '\\')
+                {
+                    *put++ = '\\';
+                    *put++ = c;
+                }
+                else if ((unsigned char)c < 0x20)
+                {
+                    put += snprintf(put, 7, "\\u%04x", (unsigned)c);
+                }
+                else
+                {
+                    *put++ = c;
+                }
+            }
+            *put++ = '"';
+        }
+        ++column;
+    }
+
+    void text(const char *value)
+    {
+        text(value, strlen(value));
+    }
+
+    void text(const string &value)
+    {
+        text(value.data(), value.size());
+    }
+
+    void number(long long value)
+    {
+        beginField();
+        char digits[24];
+        char *end = to_chars(digits, digits + sizeof(digits), value).ptr;
+        if (format == REPORT_TABLE)
+            appendPadded(digits, end - digits, columns[column].width);
+        else
+            append(digits, end - digits);
+        ++column;
+    }
+
+    // A field with no value: "-" in tables, empty in CSV, null in JSON
+    void missing()
+    {
+        beginField();
+        if (format == REPORT_TABLE)
+            appendPadded("-", 1, columns[column].width);
+        else if (format == REPORT_JSON)
+            append("null", 4);
+        ++column;
+    }
+
+    void endRow()
+    {
+        if (format == REPORT_JSON)
+            append("}\n", 2);
+        else
+            append("\n", 1);
+        column = 0;
+        ++rows;
+    }
+
+    void flush()
+    {
+        out.write(buffer.data(), put - buffer.data());
+        put = &buffer[0];
+    }
+
+    // Close the page; returns the number of rows written
+    int finish()
+    {
+        flush();
+        return rows;
+    }
+};
+
+// Room report: writes the page starting at query.cursor and moves the cursor on.
+// Returns the number of rows written.
+int writeRoomReport(ostream &out, ReportQuery &query, const RoomSnapshot &rooms)
+{
+    if (query.done)
+        return 0;
+
+    static const ReportColumn columns[] = {
+        {"Room ID", "roomId", 10},
+        {"Type", "type", 15},
+        {"Floor", "floor", 15},
+        {"Status", "status", 15}};
+
+    auto matches = [&](const Room &room)
+    {
+        return (query.floorNumber == 0 || room.floorNumber == query.floorNumber) &&
+               (query.roomType < 0 || room.type == query.roomType) &&
+               (query.status < 0 || room.status == query.status);
+    };
+
+    ReportWriter writer(out, query, columns, 4);
+    int slot = max(query.cursor, 0);
+    for (; slot < rooms.size && !query.pageFull(writer.rows); slot++)
+    {
+        const Room &room = rooms.room(slot);
+        if (!matches(room))
+            continue;
+        writer.number(room.id);
+        writer.text(ROOM_TYPE_LABELS[room.type]);
+        writer.number(room.floorNumber);
+        writer.text(ROOM_STATUS_LABELS[room.status]);
+        writer.endRow();
+    }
+    while (slot < rooms.size && !matches(rooms.room(slot)))
+        ++slot; // So a full last page also reports done
+
+    query.cursor = slot;
+    query.done = slot >= rooms.size;
+    return writer.finish();
+}
+
+// Queued request report, in the order given
+int writeRequestReport(ostream &out, ReportQuery &query, const vector<BookingRequest> &requests)
+{
+    if (query.done)
+        return 0;
+
+    static const ReportColumn columns[] = {
+        {"Customer Name", "customer", 20},
+        {"Priority", "priority", 10},
+        {"Room Type", "roomType", 15},
+        {"Floor", "floor", 10},
+        {"Nights", "nights", 10},
+        {"Check-In", "checkInDay", 10}};
+
+    auto matches = [&](const BookingRequest &request)
+    {
+        return (query.floorNumber == 0 || request.floornum == query.floorNumber) &&
+               (query.roomType < 0 || request.requestedType == query.roomType) &&
+               (query.customerName.empty() || request.customerName == query.customerName) &&
+               request.checkInDay < query.toDay && request.checkInDay + request.nights > query.fromDay;
+    };
+
+    // The cursor is a queue position, so processing requests between pages shifts it
+    ReportWriter writer(out, query, columns, 6);
+    int position = max(query.cursor, 0);
+    int count = requests.size();
+    for (; position < count && !query.pageFull(writer.rows); position++)
+    {
+        const BookingRequest &request = requests[position];
+        if (!matches(request))
+            continue;
+        writer.text(request.customerName);
+        writer.text(request.isHighPriority ? "High" : "Regular");
+        writer.text(ROOM_TYPE_LABELS[request.requestedType]);
+        writer.number(request.floornum);
+        writer.number(request.nights);
+        writer.number(request.checkInDay);
+        writer.endRow();
+    }
+    while (position < count && !matches(requests[position]))
+        ++position;
+
+    query.cursor = position;
+    query.done = position >= count;
+    return writer.finish();
+}
+
+// Booking history report, newest first. The cursor is a record index,
+// which stays valid while bookings are added between pages.
+int writeHistoryReport(ostream &out, ReportQuery &query, const HistorySnapshot &history)
+{
+    if (query.done)
+        return 0;
+
+    static const ReportColumn columns[] = {
+        {"Customer Name", "customer", 20},
+        {"Room ID", "roomId", 10},
+        {"Room Type", "roomType", 15},
+        {"Check-In", "checkInDay", 10},
+        {"Nights", "nights", 10},
+        {"Group", "groupId", 10}};
+
+    auto matches = [&](int index, BookingHistory &record)
+    {
+        if (history.isArchived(index))
+            return false;
+        record = history.get(index);
+        return (query.roomId == 0 || record.roomId == query.roomId) &&
+               (query.roomType < 0 || record.roomType == query.roomType) &&
+               (query.customerName.empty() || record.customerName == query.customerName) &&
+               record.checkInDay < query.toDay && record.checkInDay + record.nights > query.fromDay;
+    };
+
+    ReportWriter writer(out, query, columns, 6);
+    BookingHistory record;
+    int index = query.cursor < 0 ? history.total - 1 : min(query.cursor, history.total - 1);
+    for (; index >= history.baseIndex && !query.pageFull(writer.rows); index--)
+    {
+        if (!matches(index, record))
+            continue;
+        writer.text(record.customerName);
+        writer.number(record.roomId);
+        writer.text(ROOM_TYPE_LABELS[record.roomType]);
+        writer.number(record.checkInDay);
+        writer.number(record.nights);
+        if (record.groupId)
+            writer.number(record.groupId);
+        else
+            writer.missing();
+        writer.endRow();
+    }
+    while (index >= history.baseIndex && !matches(index, record))
+        --index;
+
+    query.cursor = index;
+    query.done = index < history.baseIndex;
+    return writer.finish();
+}
+
+// Custom Waitlist Implementation
+// Entries are bucketed by (floor, room type, check-in day) so that a freed
+// room only has to look at the requests that could possibly fit in it.
+struct Waitlist
+{
+    int floors;
+    WaitlistEntry **buckets;
+    int size;
+
+    // Match statistics
+    long long matched;
+    long long expired;
+    long long evaluations;
+    long long totalLatencyMicros;
+    long long maxLatencyMicros;
+
+    Waitlist(int floors)
+        : floors(floors), size(0), matched(0), expired(0), evaluations(0),
+          totalLatencyMicros(0), maxLatencyMicros(0)
+    {
+        int count = floors * 3 * MAX_DAYS;
+        buckets = new WaitlistEntry *[count];
+        for (int i = 0; i < count; i++)
+        {
+            buckets[i] = nullptr;
+        }
+    }
+
+    ~Waitlist()
+    {
+        for (int i = 0; i < floors * 3 * MAX_DAYS; i++)
+        {
+            while (buckets[i])
+            {
+                WaitlistEntry *entry = buckets[i];
+                buckets[i] = entry->next;
+                delete entry->request;
+                delete entry;
+            }
+        }
+        delete[] buckets;
+    }
+
+    WaitlistEntry **bucket(int floor, Room::RoomType type, int checkInDay)
+    {
+        return &buckets[((floor - 1) * 3 + type) * MAX_DAYS + checkInDay % MAX_DAYS];
+    }
+
+    // Append to the end of the bucket so requests are matched in arrival order
+    void add(BookingRequest *request)
+    {
+        WaitlistEntry **link = bucket(request->floornum, request->requestedType, request->checkInDay);
+        while (*link)
+        {
+            link = &(*link)->next;
+        }
+        *link = new WaitlistEntry{request, chrono::steady_clock::now(), nullptr};
+        request->next = nullptr;
+        ++size;
+    }
+
+    // Unlink an entry once its request has been booked
+    BookingRequest *remove(WaitlistEntry **link)
+    {
+        WaitlistEntry *entry = *link;
+        BookingRequest *request = entry->request;
+        *link = entry->next;
+
+        long long latency = chrono::duration_cast<chrono::microseconds>(
+                                chrono::steady_clock::now() - entry->waitlistedAt)
+                                .count();
+        totalLatencyMicros += latency;
+        if (latency > maxLatencyMicros)
+            maxLatencyMicros = latency;
+        ++matched;
+        --size;
+
+        delete entry;
+        return request;
+    }
+
+    // Drop requests for a check-in day that has passed
+    int expire(int day)
+    {
+        int dropped = 0;
+        for (int group = 0; group < floors * 3; group++)
+        {
+            WaitlistEntry **link = &buckets[group * MAX_DAYS + day % MAX_DAYS];
+            while (*link)
+            {
+                WaitlistEntry *entry = *link;
+                if (entry->request->checkInDay <= day)
+                {
+                    *link = entry->next;
+                    delete entry->request;
+                    delete entry;
+                    ++dropped;
+                }
+                else
+                {
+                    link = &entry->next;
+                }
+            }
+        }
+        size -= dropped;
+        expired += dropped;
+        return dropped;
+    }
+
+    bool isEmpty()
+    {
+        return size == 0;
+    }
+};
+
+// Hotel Management System Class
+class HotelManagementSystem
+{
+private:
+    TreeNode *root;             // Tree root for hotel floors and rooms
+    BookingQueue regularQueue;  // Regular booking queue
+    BookingQueue priorityQueue; // Priority booking queue
+    BookingStack historyStack;  // Stack for booking history
+    BookingStack archive;       // Finished stays moved out of the history
+    Waitlist waitlist;          // Requests waiting for a room to free up
+    RoomIndex roomIndex;        // Rooms grouped by floor and type
+    RoomPageTable roomViews;    // Copies of the rooms for snapshot readers
+    vector<int> guestStays;     // History index of the stay checked in to each room (by id - 1), -1 if none
+    unique_ptr<WorkStealingPool> pool; // Started by the first full-inventory scan
+    int totalFloors;
+    int nextGroupId;
+
+    // Day rollover state
+    int currentDay;
+    int firstUnclearedDay;                   // Oldest past day whose calendar slots are not recycled yet
+    vector<NightEntry> nightLists[MAX_DAYS]; // Booked nights by calendar slot
+    size_t maintenanceCursor;                // Position in nightLists for firstUnclearedDay
+    long long checkoutsProcessed;
+
+    // Helper function to insert room into the tree
+    TreeNode *insertRoom(TreeNode *node, TreeNode *newNode)
+    {
+        if (!node)
+            return newNode;
+        if (newNode->room->id < node->room->id)
+        {
+            node->left = insertRoom(node->left, newNode);
+            node->left->parent = node;
+        }
+        else
+        {
+            node->right = insertRoom(node->right, newNode);
+            node->right->parent = node;
+        }
+        return node;
+    }
+
+    // Cleanup function for tree
+    void cleanupTree(TreeNode *node)
+    {
+        if (!node)
+            return;
+        cleanupTree(node->left);
+        cleanupTree(node->right);
+        delete node->room;
+        delete node;
+    }
+
+    // Updated function to check room availability for specific dates
+    bool isRoomAvailable(Room *room, int checkInDay, int nights)
+    {
+        if (checkInDay < currentDay || checkInDay + nights > horizonEnd())
+            return false;
+
+        for (int i = checkInDay; i < checkInDay + nights; i++)
+        {
+            if (!room->availabilityCalendar[i % MAX_DAYS])
+                return false;
+        }
+        return true;
+    }
+
+    // First day that cannot be booked yet. A calendar slot is only reused for a
+    // day 30 days later once the rollover has recycled it.
+    int horizonEnd()
+    {
+        return firstUnclearedDay + MAX_DAYS;
+    }
+
+    // Check whether a room can take a new booking for the given dates.
+    // The calendar decides; a booked or occupied room can still take other nights.
+    bool isRoomBookable(Room *room, int checkInDay, int nights)
+    {
+        return room->status != Room::UNAVAILABLE && isRoomAvailable(room, checkInDay, nights);
+    }
+
+
+    // Mark room as booked for the specified dates
+    void reserveRoom(Room *room, int checkInDay, int nights)
+    {
+        for (int i = checkInDay; i < checkInDay + nights; i++)
+        {
+            room->availabilityCalendar[i % MAX_DAYS] = false;
+        }
+        if (room->status != Room::OCCUPIED)
+            room->status = Room::BOOKED; // A guest already in the room stays checked in
+        roomViews.publish(room);
+    }
+
+    // Status of a room with nobody checked in: booked while any night from
+    // today onwards is taken, ready otherwise
+    Room::Status vacantStatus(Room *room)
+    {
+        if (room->status == Room::UNAVAILABLE)
+            return Room::UNAVAILABLE;
+        for (int day = currentDay; day < horizonEnd(); day++)
+        {
+            if (!room->availabilityCalendar[day % MAX_DAYS])
+                return Room::BOOKED;
+        }
+        return Room::READY;
+    }
+
+    void setRoomStatus(Room *room, Room::Status status)
+    {
+        room->status = status;
+        roomViews.publish(room);
+    }
+
+    // A stay in this room has ended or been cancelled. Its guest leaves if they
+    // were checked in; a guest checked in for another stay stays.
+    void leaveRoom(Room *room, int historyIndex)
+    {
+        int &guestStay = guestStays[room->id - 1];
+        if (room->status == Room::OCCUPIED && guestStay != historyIndex)
+            return;
+        guestStay = -1;
+        setRoomStatus(room, vacantStatus(room));
+    }
+
+    // Record each booked night so the rollover can recycle it without scanning rooms
+    void registerNights(Room *room, int historyIndex, int checkInDay, int nights)
+    {
+        for (int i = checkInDay; i < checkInDay + nights; i++)
+        {
+            nightLists[i % MAX_DAYS].push_back(NightEntry{room, historyIndex});
+        }
+    }
+
+    // Mark nights [fromDay, toDay) as free again. Nights the rollover has already
+    // recycled belong to a later day and are left alone.
+    void releaseNights(Room *room, int fromDay, int toDay)
+    {
+        for (int i = max(fromDay, firstUnclearedDay); i < toDay; i++)
+        {
+            room->availabilityCalendar[i % MAX_DAYS] = true;
+        }
+        roomViews.publish(room);
+    }
+
+    // Move a finished stay from the booking history to the archive
+    void archiveBooking(int historyIndex)
+    {
+        archive.append(historyStack.get(historyIndex));
+        historyStack.markArchived(historyIndex);
+    }
+
+    // Check out and archive the stay a recycled night belonged to if that was its last night
+    void finishStayIfOver(const NightEntry &entry, int day)
+    {
+        int index = entry.historyIndex;
+        if (!historyStack.contains(index) || historyStack.isArchived(index))
+            return; // Cancelled or already checked out
+
+        BookingHistory record = historyStack.get(index);
+        if (record.roomId != entry.room->id || record.checkInDay + record.nights != day + 1)
+            return;
+
+        archiveBooking(index);
+        leaveRoom(entry.room, index);
+        ++checkoutsProcessed;
+    }
+
+    // Recycle past days, doing at most budget units of work.
+    // Returns true once every past day has been recycled.
+    bool runMaintenanceSlice(int budget)
+    {
+        while (firstUnclearedDay < currentDay && budget > 0)
+        {
+            vector<NightEntry> &booked = nightLists[firstUnclearedDay % MAX_DAYS];
+            while (maintenanceCursor < booked.size() && budget > 0)
+            {
+                NightEntry entry = booked[maintenanceCursor++];
+                entry.room->availabilityCalendar[firstUnclearedDay % MAX_DAYS] = true;
+                finishStayIfOver(entry, firstUnclearedDay);
+                roomViews.publish(entry.room);
+                --budget;
+            }
+            if (maintenanceCursor < booked.size())
+                break;
+
+            // Day fully recycled: drop expired waitlist entries and compact the history
+            waitlist.expire(firstUnclearedDay);
+            historyStack.compact();
+            booked.clear();
+            maintenanceCursor = 0;
+            ++firstUnclearedDay;
+            --budget;
+        }
+        return firstUnclearedDay == currentDay;
+    }
+
+    // Record a reserved stay in the booking history. Returns the history index.
+    int recordBooking(Room *room, const BookingRequest &request)
+    {
+        int index = historyStack.push(BookingHistory{
+            request.customerName,
+            request.requestedType,
+            room->id,
+            request.nights,
+            request.checkInDay,
+            0,
+            0});
+        registerNights(room, index, request.checkInDay, request.nights);
+        return index;
+    }
+
+    // Reserve a room the caller picked for a request, then commit and notify
+    // as the booking steps do
+    void confirmBooking(Room *room, BookingRequest *request)
+    {
+        reserveRoom(room, request->checkInDay, request->nights);
+        commitBooking(room->id, *request);
+        notifyBooking(cout, *request, nullptr, room->id);
+    }
+
+    // Process a single booking request through the booking steps in turn:
+    // validate, allocate, commit, notify. Returns the booked room id, or 0 if none.
+    int processSingleRequest(BookingRequest *request)
+    {
+        const char *problem = validateBooking(*request);
+        int roomId = problem ? 0 : allocateBooking(*request);
+        if (roomId)
+            commitBooking(roomId, *request);
+        notifyBooking(cout, *request, problem, roomId);
+        delete request;
+        return roomId;
+    }
+
+    // Put an unplaced request on the waitlist, unless its check-in day has passed.
+    // Callers that report outcomes themselves pass announce = false.
+    void waitlistRequest(BookingRequest *request, bool announce = true)
+    {
+        if (request->checkInDay < currentDay)
+        {
+            if (announce)
+                cout << "Request for " << request->customerName
+                     << " expired: check-in day " << request->checkInDay << " has passed." << endl;
+            delete request;
+            return;
+        }
+
+        if (announce)
+            cout << "No available room found for " << request->customerName
+                 << " on floor " << request->floornum
+                 << ". Request added to the waitlist." << endl;
+        waitlist.add(request);
+    }
+
+    // Re-evaluate only the waitlisted requests that overlap nights [fromDay, toDay)
+    // which have just been freed in this room
+    void rematchWaitlist(Room *room, int fromDay, int toDay)
+    {
+        for (int day = currentDay; day < toDay; day++)
+        {
+            WaitlistEntry **link = waitlist.bucket(room->floorNumber, room->type, day);
+            while (*link)
+            {
+                BookingRequest *request = (*link)->request;
+                if (day + request->nights <= fromDay)
+                {
+                    link = &(*link)->next;
+                    continue;
+                }
+
+                ++waitlist.evaluations;
+                if (isRoomBookable(room, day, request->nights))
+                {
+                    waitlist.remove(link);
+                    cout << "Waitlisted request matched: ";
+                    confirmBooking(room, request);
+                    delete request;
+                }
+                else
+                {
+                    link = &(*link)->next;
+                }
+            }
+        }
+    }
+
+    // Cancel most recent booking (a group booking is cancelled as a whole)
+    bool cancelMostRecentBooking()
+    {
+        if (historyStack.isEmpty())
+        {
+            cout << "No bookings to cancel.\n";
+            return false;
+        }
+
+        if (historyStack.isArchived(historyStack.size() - 1))
+        {
+            cout << "The most recent booking has already been checked out and cannot be cancelled.\n";
+            return false;
+        }
+
+        // Take the whole group off the history before freeing anything, so that
+        // waitlisted requests matched below cannot end up between its records
+        int groupId = historyStack.peek().groupId;
+        vector<BookingHistory> cancelled;
+        vector<int> cancelledIndices;
+        BookingHistory history;
+        do
+        {
+            cancelledIndices.push_back(historyStack.size() - 1);
+            historyStack.pop(history);
+            cancelled.push_back(history);
+        } while (groupId && !historyStack.isEmpty() && historyStack.peek().groupId == groupId &&
+                 !historyStack.isArchived(historyStack.size() - 1));
+
+        for (size_t i = 0; i < cancelled.size(); i++)
+        {
+            const BookingHistory &record = cancelled[i];
+            TreeNode *roomNode = findRoomById(root, record.roomId);
+            if (roomNode)
+            {
+                // Mark room as available for the specified dates. A checked-in guest
+                // only leaves if this was their stay.
+                Room *room = roomNode->room;
+                releaseNights(room, record.checkInDay, record.checkInDay + record.nights);
+                leaveRoom(room, cancelledIndices[i]);
+
+                cout << "Cancelled booking for customer: " << record.customerName
+                     << ", Room ID: " << record.roomId << ", Nights: " << record.nights << "\n";
+            }
+        }
+
+        for (const BookingHistory &record : cancelled)
+        {
+            TreeNode *roomNode = findRoomById(root, record.roomId);
+            if (roomNode)
+                rematchWaitlist(roomNode->room, record.checkInDay, record.checkInDay + record.nights);
+        }
+
+        return true;
+    }
+
+    // Pick rooms of one type from a single floor for a group booking.
+    // With adjacent set, the picked rooms must have consecutive ids.
+    int pickGroupRooms(int floor, Room::RoomType type, int count, int checkInDay, int nights,
+                       bool adjacent, Room **picked)
+    {
+        int found = 0;
+        for (Room **it = roomIndex.begin(floor, type); it != roomIndex.end(floor, type) && found < count; ++it)
+        {
+            if (isRoomBookable(*it, checkInDay, nights))
+            {
+                picked[found++] = *it;
+            }
+            else if (adjacent)
+            {
+                found = 0; // Run broken, start again after this room
+            }
+        }
+        return found;
+    }
+
+    // Score how well a stay fits the free run of a calendar that contains it.
+    // Lower is tighter; -1 means the stay does not fit at all.
+    int fitScore(const bool *calendar, int checkInDay, int nights)
+    {
+        if (checkInDay < currentDay || checkInDay + nights > horizonEnd())
+            return -1;
+        for (int i = checkInDay; i < checkInDay + nights; i++)
+        {
+            if (!calendar[i % MAX_DAYS])
+                return -1;
+        }
+
+        int leftGap = 0;
+        while (checkInDay - leftGap - 1 >= currentDay && calendar[(checkInDay - leftGap - 1) % MAX_DAYS])
+            ++leftGap;
+        int rightGap = 0;
+        while (checkInDay + nights + rightGap < horizonEnd() && calendar[(checkInDay + nights + rightGap) % MAX_DAYS])
+            ++rightGap;
+
+        // Prefer the smallest leftover run, then stays that touch an existing booking
+        // so that no free run is split into two pieces
+        return (leftGap + rightGap) * 2 + (leftGap > 0 && rightGap > 0 ? 1 : 0);
+    }
+
+    // Assign a request to a room on a scratch copy of the calendars.
+    // Returns the index of the chosen room in the room index, or -1.
+    int assignOnScratch(BookingRequest *request, bool *scratch, bool bestFit)
+    {
+        Room **first = roomIndex.begin(request->floornum, request->requestedType);
+        Room **last = roomIndex.end(request->floornum, request->requestedType);
+        int chosen = -1;
+        int bestScore = 0;
+
+        for (Room **it = first; it != last; ++it)
+        {
+            if ((*it)->status == Room::UNAVAILABLE)
+                continue;
+
+            int slot = it - roomIndex.rooms;
+            int score = fitScore(scratch + slot * MAX_DAYS, request->checkInDay, request->nights);
+            if (score < 0)
+                continue;
+            if (chosen < 0 || score < bestScore)
+            {
+                chosen = slot;
+                bestScore = score;
+            }
+            if (!bestFit || score == 0)
+                break;
+        }
+
+        if (chosen >= 0)
+        {
+            for (int i = request->checkInDay; i < request->checkInDay + request->nights; i++)
+            {
+                scratch[chosen * MAX_DAYS + i % MAX_DAYS] = false;
+            }
+        }
+        return chosen;
+    }
+
+    // Copy every room's calendar into a scratch buffer indexed like the room index
+    void copyCalendars(bool *scratch)
+    {
+        for (int slot = 0; slot < roomIndex.size(); slot++)
+        {
+            for (int i = 0; i < MAX_DAYS; i++)
+            {
+                scratch[slot * MAX_DAYS + i] = roomIndex.rooms[slot]->availabilityCalendar[i];
+            }
+        }
+    }
+
+    // Helper function to find a room by ID
+    TreeNode *findRoomById(TreeNode *node, int roomId)
+    {
+        if (!node)
+            return nullptr;
+        if (node->room->id == roomId)
+            return node;
+        TreeNode *leftSearch = findRoomById(node->left, roomId);
+        if (leftSearch)
+            return leftSearch;
+        return findRoomById(node->right, roomId);
+    }
+
+    TreeNode *findAvailableRoomOnFloor(TreeNode *node, Room::RoomType type, int floorNumber, int checkInDay, int nights)
+    {
+        if (!node)
+            return nullptr;
+
+
+        // Check if the room is on the specified floor and matches the requested type
+        if (node->room->floorNumber == floorNumber && node->room->type == type &&
+            isRoomBookable(node->room, checkInDay, nights))
+        {
+            return node;
+        }
+
+        // Search left and right subtrees
+        TreeNode *leftSearch = findAvailableRoomOnFloor(node->left, type, floorNumber, checkInDay, nights);
+        if (leftSearch)
+            return leftSearch;
+
+        return findAvailableRoomOnFloor(node->right, type, floorNumber, checkInDay, nights);
+    }
+
+public:
+    // Constructor
+    HotelManagementSystem(int floors, int roomsPerFloor)
+        : root(nullptr), waitlist(floors), roomIndex(floors, roomsPerFloor),
+          guestStays(floors * roomsPerFloor, -1), totalFloors(floors), nextGroupId(1), currentDay(0), firstUnclearedDay(0),
+          maintenanceCursor(0), checkoutsProcessed(0)
+    {
+        int idCounter = 1;
+
+        for (int floor = 1; floor <= floors; ++floor)
+        {
+            // Ensure even distribution of room types per floor
+            int singlesPerFloor = roomsPerFloor / 3;
+            int doublesPerFloor = roomsPerFloor / 3;
+            int suitesPerFloor = roomsPerFloor - singlesPerFloor - doublesPerFloor;
+
+            // Create single rooms
+            for (int i = 0; i < singlesPerFloor; ++i)
+            {
+                Room *newRoom = new Room(idCounter++, Room::SINGLE, Room::READY, floor);
+                TreeNode *newNode = new TreeNode(newRoom);
+                root = insertRoom(root, newNode);
+                roomIndex.add(newRoom);
+                roomViews.add(newRoom);
+            }
+
+            // Create double rooms
+            for (int i = 0; i < doublesPerFloor; ++i)
+            {
+                Room *newRoom = new Room(idCounter++, Room::DOUBLE, Room::READY, floor);
+                TreeNode *newNode = new TreeNode(newRoom);
+                root = insertRoom(root, newNode);
+                roomIndex.add(newRoom);
+                roomViews.add(newRoom);
+            }
+
+            // Create suites
+            for (int i = 0; i < suitesPerFloor; ++i)
+            {
+                Room *newRoom = new Room(idCounter++, Room::SUITE, Room::READY, floor);
+                TreeNode *newNode = new TreeNode(newRoom);
+                root = insertRoom(root, newNode);
+                roomIndex.add(newRoom);
+                roomViews.add(newRoom);
+            }
+        }
+    }
+    // Find the id of a bookable room without reserving it (-1 if none)
+    int findAvailableRoomId(Room::RoomType type, int floorNumber, int checkInDay, int nights)
+    {
+        TreeNode *node = findAvailableRoomOnFloor(root, type, floorNumber, checkInDay, nights);
+        return node ? node->room->id : -1;
+    }
+
+    // Snapshot of every room; safe to take and read while bookings continue
+    RoomSnapshot snapshotRooms()
+    {
+        return roomViews.snapshot();
+    }
+
+    HistorySnapshot snapshotHistory()
+    {
+        return historyStack.snapshot();
+    }
+
+    void displayRoomsByFloor(int floorNumber)
+    {
+        RoomSnapshot rooms = snapshotRooms();
+        cout << "\nRooms on Floor " << floorNumber << ":\n";
+        for (int slot = 0; slot < rooms.size; slot++)
+        {
+            const Room &room = rooms.room(slot);
+            if (room.floorNumber != floorNumber)
+                continue;
+
+            cout << "Room ID: " << room.id
+                 << ", Type: " << ROOM_TYPE_LABELS[room.type]
+                 << ", Status: " << ROOM_STATUS_LABELS[room.status] << "\n";
+        }
+    }
+
+    // Destructor
+    ~HotelManagementSystem()
+    {
+        cleanupTree(root);
+    }
+
+    // Make a booking request
+
+    bool makeBookingRequest(string name, Room::RoomType type, int nights,
+                            int checkInDay, bool isPriority, int floorNumber, int ticket = 0)
+    {
+        runMaintenanceSlice(MAINTENANCE_SLICE);
+
+        // Input validation
+        BookingRequest candidate{name, type, nights, floorNumber, checkInDay, isPriority, ticket, nullptr};
+        if (validateBooking(candidate))
+        {
+            cout << "Invalid booking parameters!\n";
+            return false;
+        }
+
+        cout << "\nChecking availability for:\n"
+             << "Customer: " << name << "\n"
+             << "Floor: " << floorNumber << "\n"
+             << "Room Type: " << ROOM_TYPE_LABELS[type]
+             << "\n"
+             << "Check-in Day: " << checkInDay << "\n"
+             << "Nights: " << nights << "\n";
+
+        // First check if there's an available room of the requested type on the specified floor
+        TreeNode *availableRoom = findAvailableRoomOnFloor(root, type, floorNumber, checkInDay, nights);
+
+        if (availableRoom)
+        {
+            // Room is available, create the booking request
+            BookingRequest *request = new BookingRequest(candidate);
+
+            // Add to appropriate queue
+            if (isPriority)
+            {
+                priorityQueue.enqueue(request);
+                cout << "High-priority booking request added successfully.\n";
+            }
+            else
+            {
+                regularQueue.enqueue(request);
+                cout << "Regular booking request added successfully.\n";
+            }
+
+            cout << "\nRoom details:"
+                 << "\nRoom ID: " << availableRoom->room->id
+                 << "\nFloor: " << availableRoom->room->floorNumber
+                 << "\nType: " << ROOM_TYPE_LABELS[availableRoom->room->type]
+                 << endl;
+        }
+        else
+        {
+            cout << "\nSorry, no available rooms of type "
+                 << ROOM_TYPE_LABELS[type]
+                 << " on floor " << floorNumber
+                 << " for the specified dates.\n"
+                 << "Please try different dates or a different floor.\n";
+            return false;
+        }
+
+        return true;
+    }
+    // Process booking requests
+    void processBookingRequests()
+    {
+        runMaintenanceSlice(MAINTENANCE_SLICE);
+        int requestsProcessed = 0;
+
+        // Handle high-priority requests first
+        while (!priorityQueue.isEmpty() && requestsProcessed < 10)
+        {
+            BookingRequest *request = priorityQueue.dequeue();
+            processSingleRequest(request);
+            ++requestsProcessed;
+        }
+
+        // Handle regular requests
+        while (!regularQueue.isEmpty() && requestsProcessed < 10)
+        {
+            BookingRequest *request = regularQueue.dequeue();
+            processSingleRequest(request);
+            ++requestsProcessed;
+        }
+
+        if (requestsProcessed == 0)
+        {
+            cout << "No requests to process.\n";
+        }
+    }
+
+    // Process every queued request, priority first, reporting (ticket, room id)
+    // for each one. A room id of 0 means the request was waitlisted or expired.
+    void processQueuedRequests(vector<pair<int, int>> &outcomes)
+    {
+        runMaintenanceSlice(MAINTENANCE_SLICE);
+        while (!priorityQueue.isEmpty() || !regularQueue.isEmpty())
+        {
+            BookingRequest *request = !priorityQueue.isEmpty() ? priorityQueue.dequeue() : regularQueue.dequeue();
+            int ticket = request->ticket;
+            outcomes.push_back(make_pair(ticket, processSingleRequest(request)));
+        }
+    }
+
+    // Process the whole pending queue at once, packing calendars with a best-fit
+    // strategy instead of taking the first room that fits. Requests that are still
+    // unplaced when the time budget runs out fall back to first fit.
+    void processBookingRequestsBatch(int timeBudgetMs)
+    {
+        runMaintenanceSlice(MAINTENANCE_SLICE);
+        int count = 0;
+        for (BookingRequest *r = priorityQueue.front; r; r = r->next)
+            ++count;
+        for (BookingRequest *r = regularQueue.front; r; r = r->next)
+            ++count;
+
+        if (count == 0)
+        {
+            cout << "No requests to process.\n";
+            return;
+        }
+
+        // Drain both queues, priority requests first
+        BookingRequest **pending = new BookingRequest *[count];
+        int n = 0;
+        while (!priorityQueue.isEmpty())
+            pending[n++] = priorityQueue.dequeue();
+        while (!regularQueue.isEmpty())
+            pending[n++] = regularQueue.dequeue();
+
+        bool *scratch = new bool[roomIndex.size() * MAX_DAYS];
+        int *assigned = new int[count];
+
+        // Baseline: the greedy first-fit path in arrival order
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        copyCalendars(scratch);
+        int greedyAccepted = 0;
+        for (int i = 0; i < count; i++)
+        {
+            if (assignOnScratch(pending[i], scratch, false) >= 0)
+                ++greedyAccepted;
+        }
+        long long greedyMicros = chrono::duration_cast<chrono::microseconds>(
+                                     chrono::steady_clock::now() - start)
+                                     .count();
+
+        // Solver: priority first, then interval-scheduling order (earliest check-out,
+        // shorter stay on ties) so each room is filled left to right without gaps
+        start = chrono::steady_clock::now();
+        chrono::steady_clock::time_point deadline = start + chrono::milliseconds(timeBudgetMs);
+        BookingRequest **order = new BookingRequest *[count];
+        for (int i = 0; i < count; i++)
+            order[i] = pending[i];
+        stable_sort(order, order + count, [](BookingRequest *a, BookingRequest *b)
+                    {
+                        if (a->isHighPriority != b->isHighPriority)
+                            return a->isHighPriority;
+                        int aEnd = a->checkInDay + a->nights;
+                        int bEnd = b->checkInDay + b->nights;
+                        if (aEnd != bEnd)
+                            return aEnd < bEnd;
+                        return a->nights < b->nights; });
+
+        copyCalendars(scratch);
+        int solverAccepted = 0;
+        bool budgetExceeded = false;
+        for (int i = 0; i < count; i++)
+        {
+            if (!budgetExceeded && chrono::steady_clock::now() > deadline)
+                budgetExceeded = true;
+            assigned[i] = assignOnScratch(order[i], scratch, !budgetExceeded);
+            if (assigned[i] >= 0)
+                ++solverAccepted;
+        }
+        long long solverMicros = chrono::duration_cast<chrono::microseconds>(
+                                     chrono::steady_clock::now() - start)
+                                     .count();
+
+        // Commit the solver's assignments; unplaced requests go to the waitlist
+        for (int i = 0; i < count; i++)
+        {
+            if (assigned[i] >= 0)
+            {
+                confirmBooking(roomIndex.rooms[assigned[i]], order[i]);
+                delete order[i];
+            }
+            else
+            {
+                waitlistRequest(order[i]);
+            }
+        }
+
+        ios::fmtflags flags = cout.flags();
+        streamsize precision = cout.precision();
+        cout << "\n--- Batch Allocation Report ---\n"
+             << "Requests: " << count << "\n"
+             << "Accepted (best fit): " << solverAccepted << " ("
+             << fixed << setprecision(1) << 100.0 * solverAccepted / count << "%)"
+             << ", solve time " << solverMicros << " us\n"
+             << "Accepted (greedy):   " << greedyAccepted << " ("
+             << 100.0 * greedyAccepted / count << "%)"
+             << ", solve time " << greedyMicros << " us\n";
+        cout.flags(flags);
+        cout.precision(precision);
+        if (budgetExceeded)
+            cout << "Time budget of " << timeBudgetMs << " ms exceeded; remaining requests used first fit.\n";
+
+        delete[] order;
+        delete[] assigned;
+        delete[] scratch;
+        delete[] pending;
+    }
+
+    // Book a block of rooms for a group in one pass over the floor/type inventory.
+    // Either every room is booked or none are. floorNumber 0 means any floor.
+    bool makeGroupBooking(const string &groupName, int singles, int doubles, int suites,
+                          int checkInDay, int nights, int floorNumber, bool sameFloor, bool adjacent)
+    {
+        int counts[3] = {singles, doubles, suites};
+        int total = singles + doubles + suites;
+
+        runMaintenanceSlice(MAINTENANCE_SLICE);
+        if (checkInDay < currentDay || nights <= 0 ||
+            checkInDay + nights > horizonEnd() || floorNumber < 0 || floorNumber > totalFloors ||
+            singles < 0 || doubles < 0 || suites < 0 || total == 0)
+        {
+            cout << "Invalid group booking parameters!\n";
+            return false;
+        }
+
+        Room **picked = new Room *[total];
+        int needed[3] = {singles, doubles, suites};
+        int pickedCount = 0;
+
+        int firstFloor = floorNumber ? floorNumber : 1;
+        int lastFloor = floorNumber ? floorNumber : totalFloors;
+        for (int floor = firstFloor; floor <= lastFloor && pickedCount < total; floor++)
+        {
+            int floorStart = pickedCount;
+            for (int type = Room::SINGLE; type <= Room::SUITE; type++)
+            {
+                if (needed[type] == 0)
+                    continue;
+
+                // Same-floor and adjacent blocks must fit a whole type on this floor
+                int want = (sameFloor || adjacent) ? counts[type] : needed[type];
+                int found = pickGroupRooms(floor, (Room::RoomType)type, want, checkInDay, nights,
+                                           adjacent, picked + pickedCount);
+                if (found == want)
+                {
+                    pickedCount += found;
+                    needed[type] = 0;
+                }
+                else if (!sameFloor && !adjacent)
+                {
+                    pickedCount += found;
+                    needed[type] -= found;
+                }
+            }
+
+            // A same-floor block that did not fit completely is discarded
+            if (sameFloor && pickedCount < total)
+            {
+                pickedCount = floorStart;
+                needed[0] = singles;
+                needed[1] = doubles;
+                needed[2] = suites;
+            }
+        }
+
+        if (pickedCount < total)
+        {
+            cout << "\nSorry, could not find " << total << " rooms for group " << groupName
+                 << " for the specified dates. No rooms were booked.\n";
+            delete[] picked;
+            return false;
+        }
+
+        // Commit all rooms under one group id
+        int groupId = nextGroupId++;
+        for (int i = 0; i < total; i++)
+        {
+            reserveRoom(picked[i], checkInDay, nights);
+            int index = historyStack.push(BookingHistory{
+                groupName, picked[i]->type, picked[i]->id, nights, checkInDay, groupId, 0});
+            registerNights(picked[i], index, checkInDay, nights);
+        }
+
+        cout << "\nGroup booking confirmed for " << groupName
+             << "\nGroup ID: " << groupId
+             << "\nRooms: ";
+        for (int i = 0; i < total; i++)
+        {
+            cout << picked[i]->id << (i + 1 < total ? ", " : "\n");
+        }
+        cout << "Check-in Day: " << checkInDay
+             << "\nNights: " << nights << endl;
+
+        delete[] picked;
+        return true;
+    }
+    bool checkInCustomer(const string &customerName)
+    {
+        // Stays that ended before today must have left their rooms first
+        finishMaintenance();
+
+        // Search for the most recent booking for this customer
+        int index = historyStack.findLatest(customerName);
+        if (index < 0)
+        {
+            cout << "No booking found for customer: " << customerName << endl;
+            return false;
+        }
+
+        BookingHistory current = historyStack.get(index);
+        int roomId = current.roomId;
+        int nights = current.nights;
+
+        // Find the room in the tree
+        TreeNode *roomNode = findRoomById(root, roomId);
+        if (!roomNode)
+        {
+            cout << "Error: Room not found in system." << endl;
+            return false;
+        }
+
+        // Guests can only check in during their own stay
+        if (current.checkInDay > currentDay || currentDay >= current.checkInDay + nights)
+        {
+            cout << "Error: The stay runs from day " << current.checkInDay << " to day "
+                 << current.checkInDay + nights - 1 << "; today is day " << currentDay << "." << endl;
+            return false;
+        }
+
+        // Check if room is already occupied
+        if (roomNode->room->status == Room::OCCUPIED)
+        {
+            if (guestStays[roomId - 1] == index)
+                cout << "Error: " << customerName << " is already checked in." << endl;
+            else
+                cout << "Error: Room is already occupied." << endl;
+            return false;
+        }
+
+        // Update room status to occupied
+        guestStays[roomId - 1] = index;
+        setRoomStatus(roomNode->room, Room::OCCUPIED);
+
+        cout << "\nCheck-in successful!" << endl;
+        cout << "Customer: " << customerName << endl;
+        cout << "Room ID: " << roomId << endl;
+        cout << "Floor: " << roomNode->room->floorNumber << endl;
+        cout << "Room Type: " << ROOM_TYPE_LABELS[roomNode->room->type]
+             << endl;
+        cout << "Number of nights: " << nights << endl;
+
+        return true;
+    }
+
+    // Check out a customer today, freeing any remaining nights of the stay
+    void checkOutCustomer(const string &customerName)
+    {
+        // Search for the most recent booking for this customer
+        int index = historyStack.findLatest(customerName);
+        if (index < 0)
+        {
+            cout << "No booking found for customer: " << customerName << endl;
+            return;
+        }
+
+        BookingHistory current = historyStack.get(index);
+        TreeNode *roomNode = findRoomById(root, current.roomId);
+        if (!roomNode)
+        {
+            cout << "Error: Room not found in system." << endl;
+            return;
+        }
+
+        int checkoutEnd = current.checkInDay + current.nights;
+        int freedFrom = currentDay > current.checkInDay ? currentDay : current.checkInDay;
+
+        if (current.checkInDay >= currentDay && guestStays[current.roomId - 1] != index)
+        {
+            // The stay has not started: cancel it rather than archive a stay of no nights.
+            // The record leaves the history without going to the archive.
+            releaseNights(roomNode->room, current.checkInDay, checkoutEnd);
+            historyStack.markArchived(index);
+            leaveRoom(roomNode->room, index);
+            cout << "\nThe stay had not started, so the booking was cancelled." << endl;
+            cout << "Cancelled booking for customer: " << customerName
+                 << ", Room ID: " << current.roomId << ", Nights: " << current.nights << endl;
+            rematchWaitlist(roomNode->room, current.checkInDay, checkoutEnd);
+            return;
+        }
+
+        cout << "\nCheck-out successful!" << endl;
+        cout << "Customer: " << customerName << endl;
+        cout << "Room ID: " << current.roomId << endl;
+
+        if (freedFrom < checkoutEnd)
+        {
+            // Early checkout: release the unused nights
+            releaseNights(roomNode->room, freedFrom, checkoutEnd);
+            historyStack.setNights(index, freedFrom - current.checkInDay);
+            cout << "Nights released: " << checkoutEnd - freedFrom << endl;
+        }
+        archiveBooking(index);
+        leaveRoom(roomNode->room, index);
+
+        rematchWaitlist(roomNode->room, freedFrom, checkoutEnd);
+    }
+
+    // Move to the next day. Stays that have ended are checked out and archived
+    // by maintenance slices that run a bounded amount of work alongside bookings.
+    void advanceDay()
+    {
+        // Finish whatever is left from the previous rollover first
+        finishMaintenance();
+
+        ++currentDay;
+        roomViews.setDay(currentDay);
+        bool done = runMaintenanceSlice(MAINTENANCE_SLICE);
+
+        cout << "Current day is now " << currentDay
+             << ". Rooms can be booked up to day " << getLastBookableDay() << ".\n"
+             << "Stays checked out so far: " << checkoutsProcessed
+             << "\nArchived bookings: " << archive.size()
+             << "\nExpired waitlist requests: " << waitlist.expired << "\n";
+        if (!done)
+            cout << "Day rollover is still in progress and will finish during the next operations.\n";
+    }
+
+    int getCurrentDay()
+    {
+        return currentDay;
+    }
+
+    Room *getRoom(int roomId)
+    {
+        return roomIndex.byId(roomId);
+    }
+
+    // Booking steps used by the synchronous path and by BookingPipeline
+
+    // Why a request cannot be booked, or nullptr if it can
+    const char *validateBooking(const BookingRequest &request)
+    {
+        if (request.requestedType < Room::SINGLE || request.requestedType > Room::SUITE)
+            return "unknown room type";
+        if (request.floornum < 1 || request.floornum > totalFloors)
+            return "no such floor";
+        if (request.nights <= 0)
+            return "stay must be at least one night";
+        if (request.checkInDay < currentDay)
+            return "check-in day has passed";
+        if (request.checkInDay + request.nights > horizonEnd())
+            return "stay ends after the last bookable day";
+        return nullptr;
+    }
+
+    // Reserve the first free room for a valid request and return its id.
+    // Returns 0 after putting a copy of the request on the waitlist.
+    int allocateBooking(const BookingRequest &request)
+    {
+        TreeNode *availableRoom = findAvailableRoomOnFloor(root, request.requestedType, request.floornum,
+                                                           request.checkInDay, request.nights);
+        if (!availableRoom)
+        {
+            waitlistRequest(new BookingRequest(request), false);
+            return 0;
+        }
+
+        reserveRoom(availableRoom->room, request.checkInDay, request.nights);
+        return availableRoom->room->id;
+    }
+
+    // Record a stay reserved by allocateBooking in the booking history
+    void commitBooking(int roomId, const BookingRequest &request)
+    {
+        recordBooking(getRoom(roomId), request);
+    }
+
+    // Tell the customer how a request went: rejected with a problem, booked
+    // into roomId, or waitlisted when roomId is 0. Touches no hotel state, so
+    // the pipeline can call it from its own thread.
+    static void notifyBooking(ostream &out, const BookingRequest &request, const char *problem, int roomId)
+    {
+        ostringstream message;
+        if (problem)
+        {
+            message << "Booking request for " << request.customerName << " rejected: " << problem << "\n";
+        }
+        else if (roomId)
+        {
+            message << "Booking confirmed for " << request.customerName
+                    << "\nRoom ID: " << roomId
+                    << "\nFloor: " << request.floornum
+                    << "\nCheck-in Day: " << request.checkInDay
+                    << "\nNights: " << request.nights << "\n";
+        }
+        else
+        {
+            message << "No available room found for " << request.customerName
+                    << " on floor " << request.floornum
+                    << ". Request added to the waitlist.\n";
+        }
+        out << message.str();
+    }
+
+    // Recycle every past day now rather than a slice at a time
+    void finishMaintenance()
+    {
+        while (!runMaintenanceSlice(MAINTENANCE_SLICE))
+        {
+        }
+    }
+
+    bool isRoomFree(int roomId, int day)
+    {
+        Room *room = roomIndex.byId(roomId);
+        return room && isRoomBookable(room, day, 1);
+    }
+
+    int getLastBookableDay()
+    {
+        return horizonEnd() - 1;
+    }
+
+    // Display waitlisted requests and match statistics
+    void displayWaitlist()
+    {
+        cout << "\n--- Waitlist ---\n";
+        cout << left << setw(20) << "Customer Name"
+             << setw(15) << "Room Type"
+             << setw(10) << "Floor"
+             << setw(10) << "Nights"
+             << setw(15) << "Check-In" << endl;
+
+        cout << setfill('-') << setw(70) << "" << setfill(' ') << endl;
+
+        if (waitlist.isEmpty())
+            cout << "No waitlisted requests.\n";
+
+        for (int floor = 1; floor <= totalFloors; floor++)
+        {
+            for (int type = Room::SINGLE; type <= Room::SUITE; type++)
+            {
+                for (int day = currentDay; day < currentDay + MAX_DAYS; day++)
+                {
+                    WaitlistEntry *entry = *waitlist.bucket(floor, (Room::RoomType)type, day);
+                    while (entry)
+                    {
+                        BookingRequest *current = entry->request;
+                        cout << left << setw(20) << current->customerName
+                             << setw(15) << ROOM_TYPE_LABELS[current->requestedType]
+                             << setw(10) << current->floornum
+                             << setw(10) << current->nights
+                             << setw(15) << "Day " << current->checkInDay << endl;
+                        entry = entry->next;
+                    }
+                }
+            }
+        }
+
+        cout << "\nWaiting: " << waitlist.size
+             << "\nMatched after cancellation/checkout: " << waitlist.matched
+             << "\nExpired: " << waitlist.expired
+             << "\nRequests re-evaluated: " << waitlist.evaluations;
+        if (waitlist.matched > 0)
+        {
+            cout << "\nAverage match latency: " << waitlist.totalLatencyMicros / waitlist.matched << " us"
+                 << "\nMax match latency: " << waitlist.maxLatencyMicros << " us";
+        }
+        cout << endl;
+    }
+
+    // Displaying booking requests, high-priority ones first
+    void displayBookingRequests()
+    {
+        cout << "\n--- Current Booking Requests ---\n";
+        ReportQuery query;
+        if (reportRequests(cout, query) == 0)
+            cout << "No booking requests.\n";
+    }
+    // Display booking history
+    void displayBookingHistory()
+    {
+        cout << "\n--- Booking History ---\n";
+        ReportQuery query;
+        if (reportHistory(cout, query) == 0)
+            cout << "No bookings in the history.\n";
+    }
+
+    // Display finished stays moved out of the history by check-out or day rollover
+    void displayArchivedBookings()
+    {
+        archive.snapshot().display("Archived Bookings");
+    }
+
+    // Display past bookings for one room
+    void displayBookingsForRoom(int roomId)
+    {
+        HistorySnapshot live = historyStack.snapshot();
+        HistorySnapshot archived = archive.snapshot();
+        cout << "\n--- Bookings for Room " << roomId << " ---\n";
+        HistorySnapshot::displayHeader();
+        int matches = 0;
+        live.forEachInRoom(roomId, [&](int index)
+                           {
+                               live.displayRecord(index);
+                               ++matches; });
+        archived.forEachInRoom(roomId, [&](int index)
+                               {
+                                   archived.displayRecord(index);
+                                   ++matches; });
+        if (matches == 0)
+            cout << "No bookings found for this room.\n";
+    }
+
+    // Display bookings whose stay overlaps days [fromDay, toDay)
+    void displayBookingsInRange(int fromDay, int toDay)
+    {
+        HistorySnapshot live = historyStack.snapshot();
+        HistorySnapshot archived = archive.snapshot();
+        cout << "\n--- Bookings from Day " << fromDay << " to Day " << toDay - 1 << " ---\n";
+        HistorySnapshot::displayHeader();
+        int matches = 0;
+        live.forEachInRange(fromDay, toDay, [&](int index)
+                            {
+                                live.displayRecord(index);
+                                ++matches; });
+        archived.forEachInRange(fromDay, toDay, [&](int index)
+                                {
+                                    archived.displayRecord(index);
+                                    ++matches; });
+        if (matches == 0)
+            cout << "No bookings found in this date range.\n";
+    }
+
+    // Reports page through snapshots, so they can run while bookings continue
+    int reportRooms(ostream &out, ReportQuery &query)
+    {
+        return writeRoomReport(out, query, snapshotRooms());
+    }
+
+    // High-priority requests come first
+    int reportRequests(ostream &out, ReportQuery &query)
+    {
+        vector<BookingRequest> requests = priorityQueue.snapshot();
+        vector<BookingRequest> regular = regularQueue.snapshot();
+        requests.insert(requests.end(), regular.begin(), regular.end());
+        return writeRequestReport(out, query, requests);
+    }
+
+    int reportHistory(ostream &out, ReportQuery &query)
+    {
+        return writeHistoryReport(out, query, snapshotHistory());
+    }
+
+    WorkStealingPool &scanPool()
+    {
+        if (!pool)
+            pool.reset(new WorkStealingPool(thread::hardware_concurrency()));
+        return *pool;
+    }
+
+    // Occupancy of the whole inventory for the next days, swept in parallel
+    void displayOccupancySummary(int days)
+    {
+        int toDay = min(currentDay + days, horizonEnd());
+        OccupancySummary summary = summarizeOccupancy(scanPool(), snapshotRooms(), currentDay, toDay);
+
+        cout << "\n--- Occupancy from Day " << currentDay << " to Day " << toDay - 1 << " ---\n";
+        cout << left << setw(15) << "Room Type" << setw(10) << "Rooms" << setw(15) << "Free all days" << endl;
+        cout << setfill('-') << setw(40) << "" << setfill(' ') << endl;
+        for (int type = Room::SINGLE; type <= Room::SUITE; type++)
+        {
+            cout << left << setw(15) << ROOM_TYPE_LABELS[type] << setw(10) << summary.byType[type]
+                 << setw(15) << summary.freeByType[type] << endl;
+        }
+
+        cout << "\nOccupied: " << summary.byStatus[Room::OCCUPIED]
+             << "\nBooked: " << summary.byStatus[Room::BOOKED]
+             << "\nReady: " << summary.byStatus[Room::READY]
+             << "\nUnavailable: " << summary.byStatus[Room::UNAVAILABLE]
+             << "\nRoom-nights booked: " << summary.bookedNights << " of " << summary.bookedNights + summary.freeNights;
+        if (summary.bookedNights + summary.freeNights > 0)
+            cout << " (" << summary.bookedNights * 100 / (summary.bookedNights + summary.freeNights) << "%)";
+        cout << endl;
+    }
+
+    // Display room status
+    void displayRoomStatus()
+    {
+        cout << "\nRoom Status:\n";
+        ReportQuery query;
+        reportRooms(cout, query);
+    }
+    // Cancel most recent booking
+    bool cancelMostRecentBookingRequest()
+    {
+        return cancelMostRecentBooking();
+    }
+};
+
+// Bounded blocking queue between two pipeline stages. push() waits while the
+// queue is full, so a slow stage holds back the ones before it instead of
+// letting the backlog grow without limit. Urgent items queue behind earlier
+// urgent ones but ahead of everything else.
+template <typename T>
+class BoundedQueue
+{
+private:
+    deque<T> items;
+    size_t urgentCount; // The first urgentCount items are the urgent ones
+    size_t capacity;
+    size_t peak;
+    bool closed;
+    mutable mutex lock;
+    condition_variable notEmpty;
+    condition_variable notFull;
+
+public:
+    explicit BoundedQueue(size_t capacity) : urgentCount(0), capacity(capacity), peak(0), closed(false) {}
+
+    void push(T item, bool urgent = false)
+    {
+        unique_lock<mutex> guard(lock);
+        notFull.wait(guard, [this]()
+                     { return items.size() < capacity; });
+        if (urgent)
+            items.insert(items.begin() + urgentCount++, move(item));
+        else
+            items.push_back(move(item));
+        peak = max(peak, items.size());
+        notEmpty.notify_one();
+    }
+
+    // Waits for an item; returns false once the queue is closed and empty
+    bool pop(T &item)
+    {
+        unique_lock<mutex> guard(lock);
+        notEmpty.wait(guard, [this]()
+                      { return !items.empty() || closed; });
+        if (items.empty())
+            return false;
+        item = move(items.front());
+        items.pop_front();
+        if (urgentCount > 0)
+            --urgentCount;
+        notFull.notify_one();
+        return true;
+    }
+
+    // No more items will be pushed
+    void close()
+    {
+        lock_guard<mutex> guard(lock);
+        closed = true;
+        notEmpty.notify_all();
+    }
+
+    size_t size() const
+    {
+        lock_guard<mutex> guard(lock);
+        return items.size();
+    }
+
+    size_t peakSize() const
+    {
+        lock_guard<mutex> guard(lock);
+        return peak;
+    }
+};
+
+// Define PipelineItem structure (one request on its way through the pipeline)
+struct PipelineItem
+{
+    BookingRequest request;
+    const char *problem; // Why validation rejected it, or nullptr
+    int roomId;          // Room reserved for it, 0 if none
+};
+
+// Define PipelineStage structure (counters for one stage)
+struct PipelineStage
+{
+    const char *name;
+    atomic<long long> processed;
+    atomic<long long> busyMicros;    // Time spent working on items
+    atomic<long long> blockedMicros; // Time spent waiting for room in the next queue
+    atomic<long long> doneMicros;    // When the stage finished its last item, from the start
+
+    PipelineStage(const char *name) : name(name), processed(0), busyMicros(0), blockedMicros(0), doneMicros(0) {}
+};
+
+// Staged Booking Pipeline
+// intake -> validation -> allocation -> commit -> notification
+// Each stage after intake runs on its own thread, with a bounded queue in front
+// of it. High-priority requests waiting for validation go ahead of regular
+// ones, as with the hotel's two request queues; from validation on requests
+// keep their order, so notifications come out in the order rooms were
+// allocated. Allocation only touches room calendars and the waitlist, and
+// commit only the booking history, so printing confirmations never holds up
+// allocation.
+// While a pipeline is running the hotel must not be used directly, apart from
+// taking snapshots. Maintenance left over from the last day change is finished
+// before the stage threads start. processSingleRequest runs the same steps one
+// request at a time; only runPipelineBenchmark drives the threaded version so far.
+class BookingPipeline
+{
+private:
+    HotelManagementSystem &hotel;
+    ostream &out;
+    PipelineStage stages[5];
+    BoundedQueue<PipelineItem> toValidate, toAllocate, toCommit, toNotify;
+    vector<thread> workers;
+    vector<pair<int, int>> outcomes; // (ticket, room id) in allocation order
+    chrono::steady_clock::time_point startedAt;
+    bool finished;
+
+    static long long microsSince(chrono::steady_clock::time_point start)
+    {
+        return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    }
+
+    // Take items from in, run work on each and pass them on to next
+    template <typename Work>
+    void runStage(PipelineStage &stage, BoundedQueue<PipelineItem> &in, BoundedQueue<PipelineItem> *next, Work work)
+    {
+        PipelineItem item;
+        while (in.pop(item))
+        {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            work(item);
+            stage.busyMicros += microsSince(start);
+            ++stage.processed;
+
+            if (next)
+            {
+                start = chrono::steady_clock::now();
+                next->push(move(item));
+                stage.blockedMicros += microsSince(start);
+            }
+        }
+        stage.doneMicros = microsSince(startedAt);
+        if (next)
+            next->close();
+    }
+
+    void notify(const PipelineItem &item)
+    {
+        HotelManagementSystem::notifyBooking(out, item.request, item.problem, item.roomId);
+        outcomes.push_back(make_pair(item.request.ticket, item.roomId));
+    }
+
+public:
+    BookingPipeline(HotelManagementSystem &hotel, ostream &out, size_t queueCapacity = PIPELINE_QUEUE_SIZE)
+        : hotel(hotel), out(out),
+          stages{"Intake", "Validation", "Allocation", "Commit", "Notification"},
+          toValidate(queueCapacity), toAllocate(queueCapacity), toCommit(queueCapacity), toNotify(queueCapacity),
+          startedAt(chrono::steady_clock::now()), finished(false)
+    {
+        hotel.finishMaintenance();
+
+        workers.push_back(thread([this]()
+                                 { runStage(stages[1], toValidate, &toAllocate, [this](PipelineItem &item)
+                                            { item.problem = this->hotel.validateBooking(item.request); }); }));
+        workers.push_back(thread([this]()
+                                 { runStage(stages[2], toAllocate, &toCommit, [this](PipelineItem &item)
+                                            {
+                                                if (!item.problem)
+                                                    item.roomId = this->hotel.allocateBooking(item.request); }); }));
+        workers.push_back(thread([this]()
+                                 { runStage(stages[3], toCommit, &toNotify, [this](PipelineItem &item)
+                                            {
+                                                if (item.roomId)
+                                                    this->hotel.commitBooking(item.roomId, item.request); }); }));
+        workers.push_back(thread([this]()
+                                 { runStage(stages[4], toNotify, nullptr, [this](PipelineItem &item)
+                                            { notify(item); }); }));
+    }
+
+    ~BookingPipeline()
+    {
+        finish();
+    }
+
+    // Intake: queue a request, waiting while validation is too far behind
+    void submit(const BookingRequest &request)
+    {
+        PipelineItem item{request, nullptr, 0};
+        item.request.next = nullptr;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        toValidate.push(move(item), request.isHighPriority);
+        stages[0].blockedMicros += microsSince(start);
+        ++stages[0].processed;
+        stages[0].doneMicros = microsSince(startedAt);
+    }
+
+    // Wait until every submitted request has been notified
+    void finish()
+    {
+        if (finished)
+            return;
+        toValidate.close();
+        for (thread &worker : workers)
+            worker.join();
+        finished = true;
+    }
+
+    // Time from the start until a stage (0 = intake, 4 = notification) finished its last item
+    double stageDoneMs(int stage)
+    {
+        return stages[stage].doneMicros / 1000.0;
+    }
+
+    // (ticket, room id) for every request, 0 when it was rejected or waitlisted.
+    // Complete once finish() has returned.
+    const vector<pair<int, int>> &results()
+    {
+        return outcomes;
+    }
+
+    void displayStats(ostream &report)
+    {
+        const BoundedQueue<PipelineItem> *queues[] = {nullptr, &toValidate, &toAllocate, &toCommit, &toNotify};
+
+        report << "\n--- Booking Pipeline ---\n"
+               << left << setw(15) << "Stage" << setw(12) << "Processed" << setw(14) << "Items/sec"
+               << setw(10) << "Busy ms" << setw(12) << "Blocked ms" << setw(10) << "Done ms"
+               << setw(10) << "Backlog" << "Peak backlog" << endl;
+        report << setfill('-') << setw(95) << "" << setfill(' ') << endl;
+        for (int i = 0; i < 5; i++)
+        {
+            PipelineStage &stage = stages[i];
+            report << left << setw(15) << stage.name << setw(12) << stage.processed
+                   << setw(14) << stage.processed * 1000000 / max(stage.doneMicros.load(), 1LL)
+                   << setw(10) << stage.busyMicros / 1000 << setw(12) << stage.blockedMicros / 1000
+                   << setw(10) << stage.doneMicros / 1000;
+            if (queues[i])
+                report << setw(10) << queues[i]->size() << queues[i]->peakSize() << endl;
+            else
+                report << setw(10) << "-" << "-" << endl;
+        }
+    }
+};
+
+// Slow console stand-in for the pipeline benchmark: every line takes a while
+// to come out, as on a busy terminal or log device
+struct SlowLineBuffer : streambuf
+{
+    int overflow(int c)
+    {
+        if (c == '\n')
+            this_thread::sleep_for(chrono::microseconds(20));
+        return c;
+    }
+};
+
+// Book the same requests synchronously and through the pipeline, with output
+// going to a slow console, and compare when allocation finished
+void runPipelineBenchmark(int requestCount)
+{
+    const int FLOORS = 20;
+    const int ROOMS_PER_FLOOR = 30;
+
+    mt19937 rng(42);
+    vector<BookingRequest> requests;
+    for (int i = 0; i < requestCount; i++)
+    {
+        int checkInDay = rng() % (MAX_DAYS - 3);
+        requests.push_back(BookingRequest{"Guest " + to_string(i), (Room::RoomType)(rng() % 3), (int)(1 + rng() % 3),
+                                          (int)(1 + rng() % FLOORS), checkInDay, rng() % 4 == 0, i + 1, nullptr});
+    }
+
+    SlowLineBuffer slowBuffer;
+    ostream slowConsole(&slowBuffer);
+
+    // Synchronous: request, allocate and print one at a time
+    HotelManagementSystem serialHotel(FLOORS, ROOMS_PER_FLOOR);
+    vector<pair<int, int>> serialOutcomes;
+    streambuf *console = cout.rdbuf(&slowBuffer);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (const BookingRequest &request : requests)
+    {
+        if (serialHotel.makeBookingRequest(request.customerName, request.requestedType, request.nights,
+                                           request.checkInDay, request.isHighPriority, request.floornum, request.ticket))
+            serialHotel.processQueuedRequests(serialOutcomes);
+        else
+            serialOutcomes.push_back(make_pair(request.ticket, 0));
+    }
+    double serialMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout.rdbuf(console);
+
+    // Pipelined
+    HotelManagementSystem pipelineHotel(FLOORS, ROOMS_PER_FLOOR);
+    start = chrono::steady_clock::now();
+    BookingPipeline pipeline(pipelineHotel, slowConsole);
+    for (const BookingRequest &request : requests)
+        pipeline.submit(request);
+    pipeline.finish();
+    double pipelineMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    // High-priority requests may overtake regular ones waiting for validation, so
+    // check the pipeline against the synchronous path fed in the order it allocated
+    const vector<pair<int, int>> &pipelineOutcomes = pipeline.results();
+    HotelManagementSystem replayHotel(FLOORS, ROOMS_PER_FLOOR);
+    vector<pair<int, int>> replayOutcomes;
+    int overtaken = 0;
+    ostringstream discarded;
+    cout.rdbuf(discarded.rdbuf());
+    for (size_t i = 0; i < pipelineOutcomes.size(); i++)
+    {
+        const BookingRequest &request = requests[pipelineOutcomes[i].first - 1];
+        if (request.ticket > (int)i + 1)
+            overtaken++;
+        if (replayHotel.makeBookingRequest(request.customerName, request.requestedType, request.nights,
+                                           request.checkInDay, request.isHighPriority, request.floornum, request.ticket))
+            replayHotel.processQueuedRequests(replayOutcomes);
+        else
+            replayOutcomes.push_back(make_pair(request.ticket, 0));
+    }
+    cout.rdbuf(console);
+
+    cout << "\n--- Pipeline Benchmark (" << requestCount << " requests, " << FLOORS * ROOMS_PER_FLOOR
+         << " rooms, slow console) ---\n"
+         << left << setw(30) << "Synchronous" << serialMs << " ms\n"
+         << setw(30) << "Pipeline, allocation done" << pipeline.stageDoneMs(2) << " ms\n"
+         << setw(30) << "Pipeline, output done" << pipelineMs << " ms\n"
+         << "Requests moved ahead by priority: " << overtaken << "\n"
+         << "Rooms assigned " << (replayOutcomes == pipelineOutcomes ? "match" : "DIFFER") << endl;
+    pipeline.displayStats(cout);
+}
+
+// Fixed Layout Hotel
+// For a deployment whose layout never changes, the constructor's split of each
+// floor into singles, doubles and suites is pure arithmetic on the room id, so
+// a room's floor and type are computed rather than stored, and each calendar is
+// a single bit word (bit d set = night d booked). Lookups are index math only.
+template <int FLOORS, int ROOMS_PER_FLOOR, int HORIZON = MAX_DAYS>
+class FixedLayoutHotel
+{
+    static_assert(FLOORS > 0 && ROOMS_PER_FLOOR >= 3, "Each floor needs at least one room of every type");
+    static_assert(HORIZON > 0 && HORIZON <= 64, "Calendar must fit in one 64-bit word");
+
+public:
+    typedef typename conditional<HORIZON <= 32, uint32_t, uint64_t>::type CalendarWord;
+
+    static constexpr int TOTAL_ROOMS = FLOORS * ROOMS_PER_FLOOR;
+    static constexpr int SINGLES_PER_FLOOR = ROOMS_PER_FLOOR / 3;
+    static constexpr int DOUBLES_PER_FLOOR = ROOMS_PER_FLOOR / 3;
+    static constexpr int SUITES_PER_FLOOR = ROOMS_PER_FLOOR - SINGLES_PER_FLOOR - DOUBLES_PER_FLOOR;
+
+    // Room ids are 1-based and assigned floor by floor, singles then doubles then suites
+    static constexpr int floorOf(int roomId)
+    {
+        return (roomId - 1) / ROOMS_PER_FLOOR + 1;
+    }
+
+    static constexpr Room::RoomType typeOf(int roomId)
+    {
+        return (roomId - 1) % ROOMS_PER_FLOOR < SINGLES_PER_FLOOR                       ? Room::SINGLE
+               : (roomId - 1) % ROOMS_PER_FLOOR < SINGLES_PER_FLOOR + DOUBLES_PER_FLOOR ? Room::DOUBLE
+                                                                                        : Room::SUITE;
+    }
+
+    static constexpr int firstRoomId(int floor, Room::RoomType type)
+    {
+        return (floor - 1) * ROOMS_PER_FLOOR + 1 +
+               (type == Room::SINGLE ? 0 : type == Room::DOUBLE ? SINGLES_PER_FLOOR
+                                                                : SINGLES_PER_FLOOR + DOUBLES_PER_FLOOR);
+    }
+
+    static constexpr int roomsOfType(Room::RoomType type)
+    {
+        return type == Room::SINGLE ? SINGLES_PER_FLOOR : type == Room::DOUBLE ? DOUBLES_PER_FLOOR
+                                                                               : SUITES_PER_FLOOR;
+    }
 
-            cout << "\nRoom details:"
-                 << "\nRoom ID: " << availableRoom->room->id
-                 << "\nFloor: " << availableRoom->room->floorNumber
-                 << "\nType: " << (availableRoom->room->type == Room::SINGLE ? "Single" : availableRoom->room->type == Room::DOUBLE ? "Double"
-                                                                                                                                    : "Suite")
-                 << endl;
+    // Bits for nights [checkInDay, checkInDay + nights)
+    static constexpr CalendarWord stayMask(int checkInDay, int nights)
+    {
+        return (nights >= (int)(8 * sizeof(CalendarWord)) ? ~CalendarWord(0) : ((CalendarWord(1) << nights) - 1))
+               << checkInDay;
+    }
+
+    FixedLayoutHotel()
+    {
+        booked.fill(0);
+        status.fill(Room::READY);
+    }
+
+    // Find the id of a bookable room without reserving it (-1 if none)
+    int findAvailableRoomId(Room::RoomType type, int floorNumber, int checkInDay, int nights) const
+    {
+        if (floorNumber < 1 || floorNumber > FLOORS || type < Room::SINGLE || type > Room::SUITE ||
+            checkInDay < 0 || nights <= 0 || checkInDay + nights > HORIZON)
+            return -1;
+
+        CalendarWord mask = stayMask(checkInDay, nights);
+        int first = firstRoomId(floorNumber, type);
+        for (int id = first; id < first + roomsOfType(type); id++)
+        {
+            if (status[id - 1] != Room::UNAVAILABLE && !(booked[id - 1] & mask))
+                return id;
         }
-        else
+        return -1;
+    }
+
+    bool isRoomAvailable(int roomId, int checkInDay, int nights) const
+    {
+        if (roomId < 1 || roomId > TOTAL_ROOMS || checkInDay < 0 || nights <= 0 || checkInDay + nights > HORIZON)
+            return false;
+        return !(booked[roomId - 1] & stayMask(checkInDay, nights));
+    }
+
+    // Returns false, reserving nothing, unless every night is free
+    bool reserveRoom(int roomId, int checkInDay, int nights)
+    {
+        if (!isRoomAvailable(roomId, checkInDay, nights))
+            return false;
+        booked[roomId - 1] |= stayMask(checkInDay, nights);
+        status[roomId - 1] = Room::BOOKED;
+        return true;
+    }
+
+private:
+    array<CalendarWord, TOTAL_ROOMS> booked;
+    array<Room::Status, TOTAL_ROOMS> status;
+};
+
+// The mapping must agree with HotelManagementSystem's constructor for the default layout
+static_assert(FixedLayoutHotel<5, 10>::floorOf(11) == 2, "Room 11 starts floor 2");
+static_assert(FixedLayoutHotel<5, 10>::typeOf(4) == Room::DOUBLE, "Rooms 4-6 are doubles");
+static_assert(FixedLayoutHotel<5, 10>::typeOf(10) == Room::SUITE, "Rooms 7-10 are suites");
+static_assert(FixedLayoutHotel<5, 10>::firstRoomId(3, Room::SUITE) == 27, "Floor 3 suites start at 27");
+
+// Compare room lookups on the dynamic tree against the fixed layout
+void runLayoutBenchmark()
+{
+    const int FLOORS = 5;
+    const int ROOMS_PER_FLOOR = 10;
+    const int LOOKUPS = 200000;
+
+    const int RESERVATIONS = 400;
+
+    HotelManagementSystem dynamicHotel(FLOORS, ROOMS_PER_FLOOR);
+    FixedLayoutHotel<FLOORS, ROOMS_PER_FLOOR> fixedHotel;
+    mt19937 rng(42);
+
+    // Book the same stays in both so lookups have to read the calendars
+    int reservationsMatched = 0;
+    for (int i = 0; i < RESERVATIONS; i++)
+    {
+        int checkInDay = rng() % MAX_DAYS;
+        BookingRequest stay{"Guest", (Room::RoomType)(rng() % 3), (int)(1 + rng() % min(4, MAX_DAYS - checkInDay)),
+                            (int)(1 + rng() % FLOORS), checkInDay, false, 0, nullptr};
+
+        int fixedId = fixedHotel.findAvailableRoomId(stay.requestedType, stay.floornum, stay.checkInDay, stay.nights);
+        if (fixedId > 0 && !fixedHotel.reserveRoom(fixedId, stay.checkInDay, stay.nights))
+            fixedId = -1;
+        int dynamicId = dynamicHotel.allocateBooking(stay);
+        reservationsMatched += (fixedId > 0 ? fixedId : 0) == dynamicId;
+    }
+
+    // Generate the same query stream for both
+    int *queries = new int[LOOKUPS * 4];
+    for (int i = 0; i < LOOKUPS; i++)
+    {
+        int checkInDay = rng() % MAX_DAYS;
+        queries[i * 4] = rng() % 3;
+        queries[i * 4 + 1] = 1 + rng() % FLOORS;
+        queries[i * 4 + 2] = checkInDay;
+        queries[i * 4 + 3] = 1 + rng() % (MAX_DAYS - checkInDay);
+    }
+
+    long long dynamicChecksum = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < LOOKUPS; i++)
+    {
+        dynamicChecksum += dynamicHotel.findAvailableRoomId((Room::RoomType)queries[i * 4], queries[i * 4 + 1],
+                                                            queries[i * 4 + 2], queries[i * 4 + 3]);
+    }
+    double dynamicNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / LOOKUPS;
+
+    long long fixedChecksum = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < LOOKUPS; i++)
+    {
+        fixedChecksum += fixedHotel.findAvailableRoomId((Room::RoomType)queries[i * 4], queries[i * 4 + 1],
+                                                        queries[i * 4 + 2], queries[i * 4 + 3]);
+    }
+    double fixedNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / LOOKUPS;
+
+    cout << "\n--- Layout Benchmark (" << FLOORS << " floors x " << ROOMS_PER_FLOOR << " rooms, "
+         << LOOKUPS << " lookups) ---\n"
+         << left << setw(20) << "Dynamic tree" << dynamicNs << " ns/lookup\n"
+         << setw(20) << "Fixed layout" << fixedNs << " ns/lookup\n"
+         << "Results " << (dynamicChecksum == fixedChecksum && reservationsMatched == RESERVATIONS ? "match" : "DIFFER")
+         << endl;
+
+    delete[] queries;
+}
+
+// Compare the report layer against per-field iostream formatting on a large
+// inventory. Rooms go straight into a page table, since the booking tree is
+// not built for this many rooms.
+void runReportBenchmark(int roomCount)
+{
+    const int ROOMS_PER_FLOOR = 100;
+
+    mt19937 rng(42);
+    RoomPageTable table;
+    BookingStack history;
+    for (int id = 1; id <= roomCount; id++)
+    {
+        Room room(id, (Room::RoomType)(rng() % 3), (Room::Status)(rng() % 4), 1 + (id - 1) / ROOMS_PER_FLOOR);
+        table.add(&room);
+
+        int checkInDay = rng() % MAX_DAYS;
+        history.push(BookingHistory{"Guest " + to_string(rng() % 5000), room.type, (int)(1 + rng() % roomCount),
+                                    (int)(1 + rng() % 5), checkInDay, id % 7 == 0 ? id / 7 : 0, 0});
+    }
+    RoomSnapshot rooms = table.snapshot();
+    HistorySnapshot records = history.snapshot();
+
+    ostringstream out;
+    auto timeMs = [&](function<void()> work)
+    {
+        out.str("");
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        work();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    // How the room and history displays formatted rows before the report layer
+    double roomsIostream = timeMs([&]()
+                                  {
+        out << left << setw(10) << "Room ID" << setw(15) << "Type" << setw(15) << "Floor" << setw(15) << "Status" << endl;
+        out << setfill('-') << setw(55) << "" << setfill(' ') << endl;
+        for (int slot = 0; slot < rooms.size; slot++)
         {
-            cout << "\nSorry, no available rooms of type "
-                 << (type == Room::SINGLE ? "Single" : type == Room::DOUBLE ? "Double"
-                                                                            : "Suite")
-                 << " on floor " << floorNumber
-                 << " for the specified dates.\n"
-                 << "Please try different dates or a different floor.\n";
+            const Room &room = rooms.room(slot);
+            out << left << setw(10) << room.id
+                << setw(15) << (room.type == Room::SINGLE ? "Single" : room.type == Room::DOUBLE ? "Double"
+                                                                                                 : "Suite")
+                << setw(15) << room.floorNumber
+                << setw(15) << (room.status == Room::OCCUPIED ? "Occupied" : room.status == Room::BOOKED ? "Booked"
+                                                             : room.status == Room::READY    ? "Ready"
+                                                                                             : "Unavailable")
+                << endl;
+        } });
+    double historyIostream = timeMs([&]()
+                                    {
+        streambuf *console = cout.rdbuf(out.rdbuf());
+        records.display("Booking History");
+        cout.rdbuf(console); });
+
+    cout << "\n--- Report Benchmark (" << roomCount << " rooms, " << records.total << " history records) ---\n"
+         << left << setw(25) << "Output" << setw(15) << "Rooms (ms)" << "History (ms)\n"
+         << setw(25) << "iostream table" << setw(15) << roomsIostream << historyIostream << "\n";
+
+    const char *names[] = {"Report table", "Report CSV", "Report JSON"};
+    for (int format = REPORT_TABLE; format <= REPORT_JSON; format++)
+    {
+        double roomsMs = timeMs([&]()
+                                {
+            ReportQuery query((ReportFormat)format);
+            writeRoomReport(out, query, rooms); });
+        double historyMs = timeMs([&]()
+                                  {
+            ReportQuery query((ReportFormat)format);
+            writeHistoryReport(out, query, records); });
+        cout << setw(25) << names[format] << setw(15) << roomsMs << historyMs << "\n";
+    }
+
+    // Paging through everything, 100 rows at a time
+    double roomsPaged = timeMs([&]()
+                               {
+        ReportQuery query(REPORT_TABLE, 100);
+        while (!query.done)
+            writeRoomReport(out, query, rooms); });
+    double historyPaged = timeMs([&]()
+                                 {
+        ReportQuery query(REPORT_TABLE, 100);
+        while (!query.done)
+            writeHistoryReport(out, query, records); });
+    cout << setw(25) << "Report table, 100/page" << setw(15) << roomsPaged << historyPaged << endl;
+}
+
+// Time full-inventory sweeps on one thread and on the work-stealing pool
+void runScanBenchmark(int roomCount)
+{
+    const int ROOMS_PER_FLOOR = 100;
+    const int REPEATS = 5;
+
+    mt19937 rng(42);
+    RoomPageTable table;
+    for (int id = 1; id <= roomCount; id++)
+    {
+        Room room(id, (Room::RoomType)(rng() % 3), rng() % 20 == 0 ? Room::UNAVAILABLE : Room::READY,
+                  1 + (id - 1) / ROOMS_PER_FLOOR);
+        for (int day = 0; day < MAX_DAYS; day++)
+            room.availabilityCalendar[day] = rng() % 4 != 0;
+        table.add(&room);
+    }
+    RoomSnapshot rooms = table.snapshot();
+
+    WorkStealingPool serial(1);
+    WorkStealingPool parallel(thread::hardware_concurrency());
+
+    auto timeMs = [&](WorkStealingPool &pool, OccupancySummary &summary, vector<int> &freeIds)
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < REPEATS; i++)
+        {
+            summary = summarizeOccupancy(pool, rooms, 0, MAX_DAYS);
+            freeIds = findFreeRoomIds(pool, rooms, Room::DOUBLE, 0, 3, 2);
+        }
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / REPEATS;
+    };
+
+    OccupancySummary serialSummary, parallelSummary;
+    vector<int> serialIds, parallelIds;
+    double serialMs = timeMs(serial, serialSummary, serialIds);
+    double parallelMs = timeMs(parallel, parallelSummary, parallelIds);
+
+    cout << "\n--- Scan Benchmark (" << roomCount << " rooms, occupancy sweep + free-room filter) ---\n"
+         << left << setw(20) << "1 thread" << serialMs << " ms\n"
+         << setw(20) << ("Pool, " + to_string(parallel.size()) + " threads") << parallelMs << " ms\n"
+         << "Free doubles found: " << parallelIds.size() << "\n"
+         << "Results " << (serialSummary == parallelSummary && serialIds == parallelIds ? "match" : "DIFFER") << endl;
+}
+
+// Take room and history reports on one thread while another books, cancels,
+// checks guests in and out and advances days, and check every page the reader
+// sees is a whole, consistent room. Meant to be run under ThreadSanitizer.
+void runSnapshotCheck(int operations)
+{
+    const int FLOORS = 5;
+    const int ROOMS_PER_FLOOR = 10;
+
+    HotelManagementSystem hotel(FLOORS, ROOMS_PER_FLOOR);
+    atomic<bool> done(false);
+    atomic<long long> rounds(0), badRooms(0);
+
+    thread reader([&]()
+                  {
+                      ostringstream out;
+                      while (!done)
+                      {
+                          RoomSnapshot rooms = hotel.snapshotRooms();
+                          for (int slot = 0; slot < rooms.size; slot++)
+                          {
+                              const Room &room = rooms.room(slot);
+                              if (room.id != slot + 1 || room.floorNumber != 1 + slot / ROOMS_PER_FLOOR)
+                                  ++badRooms;
+                          }
+
+                          ReportQuery roomQuery(REPORT_CSV), historyQuery(REPORT_JSON);
+                          out.str("");
+                          if (hotel.reportRooms(out, roomQuery) != FLOORS * ROOMS_PER_FLOOR)
+                              ++badRooms;
+                          hotel.reportHistory(out, historyQuery);
+                          ++rounds;
+                      } });
+
+    mt19937 rng(7);
+    ostringstream discarded;
+    streambuf *console = cout.rdbuf(discarded.rdbuf());
+    for (int i = 0; i < operations; i++)
+    {
+        string name = "Guest " + to_string(rng() % 200);
+        switch (rng() % 10)
+        {
+        case 6:
+            hotel.cancelMostRecentBookingRequest();
+            break;
+        case 7:
+            hotel.checkInCustomer(name);
+            break;
+        case 8:
+            hotel.checkOutCustomer(name);
+            break;
+        case 9:
+            if (i % 5 == 0)
+            {
+                hotel.advanceDay();
+                break;
+            }
+            // fall through
+        default:
+            if (hotel.makeBookingRequest(name, (Room::RoomType)(rng() % 3), (int)(1 + rng() % 3),
+                                         hotel.getCurrentDay() + (int)(rng() % (MAX_DAYS - 4)), rng() % 4 == 0,
+                                         (int)(1 + rng() % FLOORS)))
+                hotel.processBookingRequests();
+            break;
         }
+        if (i % 256 == 0)
+            discarded.str("");
     }
-    // Process booking requests
-    void processBookingRequests()
+    cout.rdbuf(console);
+    done = true;
+    reader.join();
+
+    cout << "\n--- Snapshot Check (" << operations << " operations, " << FLOORS * ROOMS_PER_FLOOR << " rooms) ---\n"
+         << "Reader rounds: " << rounds << "\n"
+         << "Inconsistent rooms seen: " << badRooms << "\n"
+         << "Snapshots " << (badRooms == 0 ? "consistent" : "INCONSISTENT") << endl;
+}
+
+// Utility Class
+class InputHandler
+{
+public:
+    // Function to read an integer with validation
+    static int readInt(const string &prompt)
     {
-        int requestsProcessed = 0;
+        int value;
+        while (true)
+        {
+            cout << prompt;
+            cin >> value;
 
-        // Handle high-priority requests first
-        while (!priorityQueue.isEmpty() && requestsProcessed < 10)
+            if (cin.fail())
+            {
+                cin.clear();                                         // Clear the error flag
+                cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Discard invalid input
+                cout << "Invalid input! Please enter a valid integer.\n";
+            }
+            else
+            {
+                cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Discard the rest of the line
+                return value;
+            }
+        }
+    }
+
+    // Function to read a string
+    static string readString(const string &prompt)
+    {
+        string value;
+        cout << prompt;
+        cin.ignore();
+        getline(cin, value);
+        return value;
+    }
+
+    // Function to read a boolean (1 for true, 0 for false)
+    static bool readBool(const string &prompt)
+    {
+        int value;
+        while (true)
         {
-            BookingRequest *request = priorityQueue.dequeue();
-            processSingleRequest(request);
-            ++requestsProcessed;
+            value = readInt(prompt);
+            if (value == 0 || value == 1)
+            {
+                return value == 1;
+            }
+            else
+            {
+                cout << "Invalid input! Please enter 1 (Yes) or 0 (No).\n";
+            }
+        }
+    }
+};
+// Utility functions
+void clearScreen()
+{
+    system("cls");
+}
+
+void waitForEnter()
+{
+
+    cin.clear();
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    cout << "Press Enter to continue...";
+    cin.get();
+}
+
+#ifdef __linux__
+// Local Request Server
+// Clients connect over a Unix domain socket and send one request per line:
+//   B <name> <type 0-2> <nights> <checkInDay> <priority 0/1> <floor>   make a booking
+//   P                                                                  process queued bookings
+//   C                                                                  cancel most recent booking
+//   I <name>                                                           check in a customer
+//   Q <roomId> <day>                                                   room status and availability
+// Each request gets one reply line, in order: "OK ...", "WAIT", "NO" or "ERR".
+// A booking is answered once it has been allocated, with "OK <roomId>" or "WAIT".
+// A line longer than MAX_REQUEST_LINE bytes is answered with "ERR" and the
+// client is disconnected.
+
+const size_t MAX_REQUEST_LINE = 4096; // Bytes a client may send without a newline
+
+// Discards everything written to it; silences the console output in server mode
+struct NullBuffer : streambuf
+{
+    int overflow(int c)
+    {
+        return c;
+    }
+};
+
+// Define ClientConnection structure
+struct ClientConnection
+{
+    int fd;
+    string input;  // Bytes received but not yet parsed into requests
+    string output; // Replies not yet written
+    bool closed;
+};
+
+// Define ServerCommand structure (one parsed request waiting for its reply)
+struct ServerCommand
+{
+    ClientConnection *client;
+    string line;
+    string reply;
+};
+
+volatile sig_atomic_t serverRunning = 1;
+
+void stopServer(int)
+{
+    serverRunning = 0;
+}
+
+class RequestServer
+{
+private:
+    HotelManagementSystem &hotel;
+    int listenFd;
+    int epollFd;
+    unordered_map<int, ClientConnection *> clients;
+    int nextTicket;
+
+    // Statistics
+    long long wakeups;
+    long long requests;
+    long long bookingBatches;
+
+    static bool setNonBlocking(int fd)
+    {
+        int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
+    void acceptClients()
+    {
+        while (true)
+        {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0)
+                return;
+            setNonBlocking(fd);
+
+            ClientConnection *client = new ClientConnection{fd, "", "", false};
+            epoll_event event = {};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+            clients[fd] = client;
+        }
+    }
+
+    // Read everything available and split it into complete request lines
+    void readRequests(ClientConnection *client, vector<ServerCommand> &batch)
+    {
+        char buffer[65536];
+        while (true)
+        {
+            ssize_t received = read(client->fd, buffer, sizeof(buffer));
+            if (received > 0)
+            {
+                client->input.append(buffer, received);
+                splitRequests(client, batch);
+                if (client->input.size() > MAX_REQUEST_LINE)
+                {
+                    // A line that never ends: answer it with ERR (an empty request) and hang up
+                    batch.push_back(ServerCommand{client, "", ""});
+                    client->input.clear();
+                    client->closed = true;
+                    break;
+                }
+                continue;
+            }
+            if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+                client->closed = true;
+            break;
+        }
+    }
+
+    void splitRequests(ClientConnection *client, vector<ServerCommand> &batch)
+    {
+        size_t start = 0;
+        size_t end;
+        while ((end = client->input.find('\n', start)) != string::npos)
+        {
+            batch.push_back(ServerCommand{client, client->input.substr(start, end - start), ""});
+            start = end + 1;
+        }
+        client->input.erase(0, start);
+    }
+
+    // Allocate every booking queued so far and fill in their replies
+    void flushBookings(vector<ServerCommand> &batch, unordered_map<int, size_t> &pending)
+    {
+        if (pending.empty())
+            return;
+
+        vector<pair<int, int>> outcomes;
+        hotel.processQueuedRequests(outcomes);
+        for (size_t i = 0; i < outcomes.size(); i++)
+        {
+            unordered_map<int, size_t>::iterator found = pending.find(outcomes[i].first);
+            if (found != pending.end())
+                batch[found->second].reply = outcomes[i].second ? "OK " + to_string(outcomes[i].second) : "WAIT";
+        }
+        pending.clear();
+        ++bookingBatches;
+    }
+
+    // Run one wakeup's requests against the hotel. Consecutive bookings are
+    // queued and allocated together; any other request first sees their effect.
+    void executeBatch(vector<ServerCommand> &batch)
+    {
+        unordered_map<int, size_t> pending; // Ticket -> position in batch
+
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            istringstream fields(batch[i].line);
+            string op;
+            fields >> op;
+
+            if (op == "B")
+            {
+                string name;
+                int type, nights, checkInDay, priority, floor;
+                if (!(fields >> name >> type >> nights >> checkInDay >> priority >> floor) || type < 0 || type > 2)
+                {
+                    batch[i].reply = "ERR";
+                    continue;
+                }
+                int ticket = nextTicket++;
+                if (hotel.makeBookingRequest(name, (Room::RoomType)type, nights, checkInDay, priority, floor, ticket))
+                    pending[ticket] = i;
+                else
+                    batch[i].reply = "NO";
+                continue;
+            }
+
+            flushBookings(batch, pending);
+            if (op == "P")
+            {
+                batch[i].reply = "OK";
+            }
+            else if (op == "C")
+            {
+                batch[i].reply = hotel.cancelMostRecentBookingRequest() ? "OK" : "NO";
+            }
+            else if (op == "I")
+            {
+                string name;
+                if (fields >> name)
+                    batch[i].reply = hotel.checkInCustomer(name) ? "OK" : "NO";
+                else
+                    batch[i].reply = "ERR";
+            }
+            else if (op == "Q")
+            {
+                int roomId, day;
+                Room *room = (fields >> roomId >> day) ? hotel.getRoom(roomId) : nullptr;
+                if (room)
+                    batch[i].reply = string("OK ") +
+                                     ROOM_STATUS_LABELS[room->status] +
+                                     (hotel.isRoomFree(roomId, day) ? " 1" : " 0");
+                else
+                    batch[i].reply = "ERR";
+            }
+            else
+            {
+                batch[i].reply = "ERR";
+            }
         }
+        flushBookings(batch, pending);
+        requests += batch.size();
+    }
 
-        // Handle regular requests
-        while (!regularQueue.isEmpty() && requestsProcessed < 10)
+    // Write as much queued output as the socket takes; wait for EPOLLOUT otherwise.
+    // A client that has stopped sending is only watched until its replies are out.
+    void flushOutput(ClientConnection *client)
+    {
+        while (!client->output.empty())
         {
-            BookingRequest *request = regularQueue.dequeue();
-            processSingleRequest(request);
-            ++requestsProcessed;
+            ssize_t sent = write(client->fd, client->output.data(), client->output.size());
+            if (sent > 0)
+            {
+                client->output.erase(0, sent);
+                continue;
+            }
+            if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                break;
+
+            // The client is gone and nobody will read the rest
+            client->output.clear();
+            client->closed = true;
         }
 
-        if (requestsProcessed == 0)
+        epoll_event event = {};
+        event.events = 0;
+        if (!client->closed)
+            event.events |= EPOLLIN;
+        if (!client->output.empty())
+            event.events |= EPOLLOUT;
+        event.data.fd = client->fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, client->fd, &event);
+    }
+
+    void closeClient(ClientConnection *client)
+    {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, client->fd, nullptr);
+        close(client->fd);
+        clients.erase(client->fd);
+        delete client;
+    }
+
+public:
+    RequestServer(HotelManagementSystem &hotel)
+        : hotel(hotel), listenFd(-1), epollFd(-1), nextTicket(1),
+          wakeups(0), requests(0), bookingBatches(0)
+    {
+    }
+
+    ~RequestServer()
+    {
+        while (!clients.empty())
         {
-            cout << "No requests to process.\n";
+            closeClient(clients.begin()->second);
         }
+        if (listenFd >= 0)
+            close(listenFd);
+        if (epollFd >= 0)
+            close(epollFd);
     }
-    void checkInCustomer(const string &customerName)
+
+    bool start(const string &socketPath)
     {
-        // First search in booking history
-        BookingHistory *current = historyStack.top;
-        bool found = false;
-        int roomId = -1;
-        int nights = 0;
+        sockaddr_un address = {};
+        if (socketPath.size() >= sizeof(address.sun_path))
+        {
+            cerr << "Socket path is too long.\n";
+            return false;
+        }
+        address.sun_family = AF_UNIX;
+        strcpy(address.sun_path, socketPath.c_str());
 
-        // Search for the most recent booking for this customer
-        while (current)
+        // Replace a socket left behind by an earlier run, but never any other file
+        struct stat existing;
+        if (lstat(socketPath.c_str(), &existing) == 0)
         {
-            if (current->customerName == customerName)
+            if (!S_ISSOCK(existing.st_mode))
             {
-                roomId = current->roomId;
-                nights = current->nights;
-                found = true;
-                break;
+                cerr << socketPath << " already exists and is not a socket.\n";
+                return false;
             }
-            current = current->next;
+            unlink(socketPath.c_str());
         }
 
-        if (!found)
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0 || bind(listenFd, (sockaddr *)&address, sizeof(address)) < 0 ||
+            listen(listenFd, SOMAXCONN) < 0 || !setNonBlocking(listenFd))
         {
-            cout << "No booking found for customer: " << customerName << endl;
-            return;
+            cerr << "Could not listen on " << socketPath << ": " << strerror(errno) << "\n";
+            return false;
         }
 
-        // Find the room in the tree
-        TreeNode *roomNode = findRoomById(root, roomId);
-        if (!roomNode)
+        epollFd = epoll_create1(0);
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        if (epollFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) < 0)
         {
-            cout << "Error: Room not found in system." << endl;
-            return;
+            cerr << "Could not create event loop: " << strerror(errno) << "\n";
+            return false;
         }
+        return true;
+    }
 
-        // Check if room is already occupied
-        if (roomNode->room->status == Room::OCCUPIED)
-        {
-            cout << "Error: Room is already occupied." << endl;
-            return;
-        }
+    // Event loop: every wakeup gathers requests from all ready clients and
+    // runs them as one batch before replying
+    void run()
+    {
+        const int MAX_EVENTS = 256;
+        epoll_event events[MAX_EVENTS];
+        vector<ServerCommand> batch;
+        vector<ClientConnection *> touched;
 
-        // Update room status to occupied
-        roomNode->room->status = Room::OCCUPIED;
+        while (serverRunning)
+        {
+            int ready = epoll_wait(epollFd, events, MAX_EVENTS, 500);
+            if (ready <= 0)
+                continue;
+            ++wakeups;
 
-        cout << "\nCheck-in successful!" << endl;
-        cout << "Customer: " << customerName << endl;
-        cout << "Room ID: " << roomId << endl;
-        cout << "Floor: " << roomNode->room->floorNumber << endl;
-        cout << "Room Type: " << (roomNode->room->type == Room::SINGLE ? "Single" : roomNode->room->type == Room::DOUBLE ? "Double"
-                                                                                                                         : "Suite")
-             << endl;
-        cout << "Number of nights: " << nights << endl;
-    }
+            batch.clear();
+            touched.clear();
+            for (int i = 0; i < ready; i++)
+            {
+                if (events[i].data.fd == listenFd)
+                {
+                    acceptClients();
+                    continue;
+                }
 
-    // Displaying booking requests
-    void displayBookingRequests()
-    {
-        cout << "\n--- Current Booking Requests ---\n";
-        cout << left << setw(20) << "Customer Name"
-             << setw(15) << "Room Type"
-             << setw(10) << "Floor"
-             << setw(10) << "Nights"
-             << setw(15) << "Check-In" << endl;
+                ClientConnection *client = clients[events[i].data.fd];
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+                    readRequests(client, batch);
+                touched.push_back(client);
+            }
 
-        cout << setfill('-') << setw(70) << "" << setfill(' ') << endl;
+            executeBatch(batch);
 
-        // Display priority requests
-        cout << "\nHigh-Priority Requests:\n";
-        BookingRequest *current = priorityQueue.front;
-        if (!current)
-            cout << "No high-priority requests.\n";
-        while (current)
-        {
-            cout << left << setw(20) << current->customerName
-                 << setw(15) << (current->requestedType == Room::SINGLE ? "Single" : current->requestedType == Room::DOUBLE ? "Double"
-                                                                                                                            : "Suite")
-                 << setw(10) << current->floornum
-                 << setw(10) << current->nights
-                 << setw(15) << "Day " << current->checkInDay << endl;
-            current = current->next;
-        }
-
-        // Display regular requests
-        cout << "\nRegular Requests:\n";
-        current = regularQueue.front;
-        if (!current)
-            cout << "No regular requests.\n";
-        while (current)
-        {
-            cout << left << setw(20) << current->customerName
-                 << setw(15) << (current->requestedType == Room::SINGLE ? "Single" : current->requestedType == Room::DOUBLE ? "Double"
-                                                                                                                            : "Suite")
-                 << setw(10) << current->floornum
-                 << setw(10) << current->nights
-                 << setw(15) << "Day " << current->checkInDay << endl;
-            current = current->next;
+            for (size_t i = 0; i < batch.size(); i++)
+            {
+                batch[i].client->output += batch[i].reply;
+                batch[i].client->output += '\n';
+            }
+            // Reply before closing, so a client that half-closes after sending
+            // still gets an answer to every request
+            for (size_t i = 0; i < touched.size(); i++)
+            {
+                flushOutput(touched[i]);
+                if (touched[i]->closed && touched[i]->output.empty())
+                    closeClient(touched[i]);
+            }
         }
+
+        cerr << "Server stopped after " << requests << " requests in " << wakeups << " wakeups ("
+             << bookingBatches << " booking batches).\n";
     }
-    // Display booking history
-    void displayBookingHistory()
+};
+
+// Serve requests for a hotel until interrupted
+int runServer(const string &socketPath, int floors, int roomsPerFloor)
+{
+    if (floors < 1 || roomsPerFloor < 3)
     {
-        historyStack.display();
+        cerr << "A hotel needs at least 1 floor and 3 rooms per floor.\n";
+        return 1;
     }
 
-    // Display room status
-    void displayRoomStatus()
-    {
-        cout << "\nRoom Status:\n";
-        cout << left << setw(10) << "Room ID"
-             << setw(15) << "Type"
-             << setw(15) << "Floor"
-             << setw(15) << "Status" << endl;
+    HotelManagementSystem hotel(floors, roomsPerFloor);
+    RequestServer server(hotel);
+    if (!server.start(socketPath))
+        return 1;
 
-        cout << setfill('-') << setw(55) << "" << setfill(' ') << endl; // Separator line
+    signal(SIGINT, stopServer);
+    signal(SIGTERM, stopServer);
+    signal(SIGPIPE, SIG_IGN);
+    cerr << "Galaxy Hotel server listening on " << socketPath << " (" << floors << " floors x "
+         << roomsPerFloor << " rooms). Press Ctrl+C to stop.\n";
 
-        displayRoomStatusHelper(root);
-    }
-    // Cancel most recent booking
-    void cancelMostRecentBookingRequest()
-    {
-        cancelMostRecentBooking();
-    }
-};
-// Utility Class
-class InputHandler
+    // The hotel reports to the console; nobody is reading it in server mode
+    NullBuffer nullBuffer;
+    streambuf *console = cout.rdbuf(&nullBuffer);
+    server.run();
+    cout.rdbuf(console);
+
+    unlink(socketPath.c_str());
+    return 0;
+}
+
+// Local load-test client: every connection keeps a window of requests in
+// flight and records the latency of each reply
+int runLoadTest(const string &socketPath, int connections, int requestsPerConnection)
 {
-public:
-    // Function to read an integer with validation
-    static int readInt(const string &prompt)
+    if (connections < 1 || requestsPerConnection < 1)
     {
-        int value;
-        while (true)
-        {
-            cout << prompt;
-            cin >> value;
+        cerr << "Need at least 1 connection and 1 request per connection.\n";
+        return 1;
+    }
 
-            if (cin.fail())
+    const int WINDOW = 32;
+    vector<vector<double>> latencies(connections);
+    vector<thread> workers;
+    atomic<bool> failed(false); // Set by any connection thread that loses the server
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int c = 0; c < connections; c++)
+    {
+        workers.push_back(thread([&, c]()
+                                 {
+            sockaddr_un address = {};
+            address.sun_family = AF_UNIX;
+            strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+            int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (fd < 0 || connect(fd, (sockaddr *)&address, sizeof(address)) < 0)
             {
-                cin.clear();                                         // Clear the error flag
-                cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Discard invalid input
-                cout << "Invalid input! Please enter a valid integer.\n";
+                failed = true;
+                if (fd >= 0)
+                    close(fd);
+                return;
             }
-            else
+
+            mt19937 rng(c + 1);
+            deque<chrono::steady_clock::time_point> inFlight;
+            int sent = 0;
+            int received = 0;
+            char buffer[65536];
+            while (received < requestsPerConnection)
             {
-                cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Discard the rest of the line
-                return value;
+                // Top up the window with a pipelined burst of requests
+                string burst;
+                while (sent < requestsPerConnection && (int)inFlight.size() < WINDOW)
+                {
+                    int kind = sent % 10;
+                    if (kind < 7)
+                    {
+                        int checkInDay = rng() % (MAX_DAYS - 1);
+                        burst += "B load" + to_string(c) + "_" + to_string(sent) + " " + to_string(rng() % 3) + " " +
+                                 to_string(1 + rng() % 3) + " " + to_string(checkInDay) + " " +
+                                 to_string(rng() % 5 == 0) + " " + to_string(1 + rng() % 5) + "\n";
+                    }
+                    else if (kind < 9)
+                    {
+                        burst += "Q " + to_string(1 + rng() % 50) + " " + to_string(rng() % MAX_DAYS) + "\n";
+                    }
+                    else
+                    {
+                        burst += "I load" + to_string(c) + "_" + to_string(sent - 9) + "\n";
+                    }
+                    inFlight.push_back(chrono::steady_clock::now());
+                    ++sent;
+                }
+                if (!burst.empty() && write(fd, burst.data(), burst.size()) != (ssize_t)burst.size())
+                {
+                    failed = true;
+                    break;
+                }
+
+                ssize_t count = read(fd, buffer, sizeof(buffer));
+                if (count <= 0)
+                {
+                    failed = true;
+                    break;
+                }
+                chrono::steady_clock::time_point now = chrono::steady_clock::now();
+                for (ssize_t i = 0; i < count; i++)
+                {
+                    if (buffer[i] != '\n')
+                        continue;
+                    latencies[c].push_back(chrono::duration<double, micro>(now - inFlight.front()).count());
+                    inFlight.pop_front();
+                    ++received;
+                }
             }
-        }
+            close(fd); }));
     }
-
-    // Function to read a string
-    static string readString(const string &prompt)
+    for (size_t i = 0; i < workers.size(); i++)
     {
-        string value;
-        cout << prompt;
-        cin.ignore();
-        getline(cin, value);
-        return value;
+        workers[i].join();
     }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
 
-    // Function to read a boolean (1 for true, 0 for false)
-    static bool readBool(const string &prompt)
+    if (failed)
     {
-        int value;
-        while (true)
-        {
-            value = readInt(prompt);
-            if (value == 0 || value == 1)
-            {
-                return value == 1;
-            }
-            else
-            {
-                cout << "Invalid input! Please enter 1 (Yes) or 0 (No).\n";
-            }
-        }
+        cerr << "Load test failed: could not talk to the server on " << socketPath << "\n";
+        return 1;
     }
-};
-// Utility functions
-void clearScreen()
-{
-    system("cls");
-}
-
-void waitForEnter()
-{
 
-    cin.clear();
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    vector<double> all;
+    for (int c = 0; c < connections; c++)
+    {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+    }
+    sort(all.begin(), all.end());
 
-    cout << "Press Enter to continue...";
-    cin.get();
+    cout << "\n--- Load Test (" << connections << " connections x " << requestsPerConnection << " requests) ---\n"
+         << left << setw(20) << "Requests" << all.size() << "\n"
+         << setw(20) << "Throughput" << (long long)(all.size() / seconds) << " requests/sec\n"
+         << setw(20) << "p50 latency" << all[all.size() / 2] << " us\n"
+         << setw(20) << "p99 latency" << all[all.size() * 99 / 100] << " us\n"
+         << setw(20) << "Max latency" << all.back() << " us" << endl;
+    return 0;
 }
+#endif
 
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1 && string(argv[1]) == "--bench-layout")
+    {
+        runLayoutBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-report")
+    {
+        runReportBenchmark(argc > 2 ? atoi(argv[2]) : 100000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-pipeline")
+    {
+        runPipelineBenchmark(argc > 2 ? atoi(argv[2]) : 2000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-scan")
+    {
+        runScanBenchmark(argc > 2 ? atoi(argv[2]) : 500000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--check-snapshots")
+    {
+        runSnapshotCheck(argc > 2 ? atoi(argv[2]) : 20000);
+        return 0;
+    }
+#ifdef __linux__
+    if (argc > 2 && string(argv[1]) == "--serve")
+    {
+        if (argc != 3 && argc != 5)
+        {
+            cerr << "Usage: " << argv[0] << " --serve <socket-path> [floors rooms-per-floor]\n";
+            return 1;
+        }
+        return runServer(argv[2], argc > 4 ? atoi(argv[3]) : 5, argc > 4 ? atoi(argv[4]) : 10);
+    }
+    if (argc > 2 && string(argv[1]) == "--loadtest")
+    {
+        if (argc != 3 && argc != 5)
+        {
+            cerr << "Usage: " << argv[0] << " --loadtest <socket-path> [connections requests-per-connection]\n";
+            return 1;
+        }
+        return runLoadTest(argv[2], argc > 4 ? atoi(argv[3]) : 8, argc > 4 ? atoi(argv[4]) : 10000);
+    }
+#endif
+
     cout << endl<<endl;
     cout << "                                                                                ------------------------------------------------------------" << endl;
     cout << "                                                                                |                  <Welcome to Galaxy Hotel>               |" << endl;
@@ -752,6 +4113,15 @@ cout << "   6. Display rooms by floor   \n";
 cout << "   7. Display booking requests   \n";
 cout << "   8. Customer Check-in         \n";
 cout << "   9. Exit                     \n";
+cout << "  10. Customer Check-out        \n";
+cout << "  11. Display waitlist          \n";
+cout << "  12. Make a group booking      \n";
+cout << "  13. Batch process requests    \n";
+cout << "  14. Search booking history    \n";
+cout << "  15. Advance to next day       \n";
+cout << "  16. Display archived bookings \n";
+cout << "  17. Export a report           \n";
+cout << "  18. Occupancy summary         \n";
 cout << " ==============================\n";
 cout << "   Enter your choice: ";
 
@@ -764,9 +4134,9 @@ cout << "   Enter your choice: ";
             continue;
         }
 
-        if (choice < 1 || choice > 9)
+        if (choice < 1 || choice > 18)
         {
-            cout << "Invalid choice! Please enter a number between 1 and 8.\n";
+            cout << "Invalid choice! Please enter a number between 1 and 18.\n";
             continue;
         }
 
@@ -814,12 +4184,14 @@ cout << "   Enter your choice: ";
                     cout << "Invalid number of nights! Please enter a positive value.\n";
                 }
             }
-            int checkInDay = InputHandler::readInt("Enter check-in day (0-29): ");
+            int checkInDay = InputHandler::readInt("Enter check-in day (" + to_string(hotel.getCurrentDay()) + "-" +
+                                                   to_string(hotel.getLastBookableDay()) + "): ");
 
             // Validate check-in day
-            if (checkInDay < 0 || checkInDay >= MAX_DAYS)
+            if (checkInDay < hotel.getCurrentDay() || checkInDay > hotel.getLastBookableDay())
             {
-                cout << "Invalid check-in day! Please enter a day between 0 and 29.\n";
+                cout << "Invalid check-in day! Please enter a day between " << hotel.getCurrentDay()
+                     << " and " << hotel.getLastBookableDay() << ".\n";
                 break;
             }
             int priority = InputHandler::readInt("Is this a high-priority request? (1: Yes, 0: No): ");
@@ -904,6 +4276,161 @@ cout << "   Enter your choice: ";
             cout << "Thank you for using Galaxy Hotel Management System. Exiting...\n";
             return 0;
         }
+        case 10:
+        {
+            clearScreen();
+            cout << "\t\t\t\t------------------\n";
+            cout << "\t\t\t\tCUSTOMER CHECK-OUT\n";
+            cout << "\t\t\t\t------------------\n\n";
+            string customerName = InputHandler::readString("Enter customer name for check-out: ");
+            hotel.checkOutCustomer(customerName);
+            waitForEnter();
+            break;
+        }
+        case 11:
+        {
+            clearScreen();
+            cout << "\t\t\t\t-------------------\n";
+            cout << "\t\t\t\tDISPLAYING WAITLIST\n";
+            cout << "\t\t\t\t-------------------\n\n";
+            hotel.displayWaitlist();
+            waitForEnter();
+            break;
+        }
+        case 12:
+        {
+            clearScreen();
+            cout << "\t\t\t\t-----------------------\n";
+            cout << "\t\t\t\t REGISTER GROUP BOOKING\n";
+            cout << "\t\t\t\t-----------------------\n\n";
+            string groupName = InputHandler::readString("Enter Group Name: ");
+            int singles = InputHandler::readInt("Number of Single rooms: ");
+            int doubles = InputHandler::readInt("Number of Double rooms: ");
+            int suites = InputHandler::readInt("Number of Suites: ");
+            int checkInDay = InputHandler::readInt("Enter check-in day (" + to_string(hotel.getCurrentDay()) + "-" +
+                                                   to_string(hotel.getLastBookableDay()) + "): ");
+            int nights = InputHandler::readInt("Enter number of nights: ");
+            int floorNumber = InputHandler::readInt("Enter the floor number (1 to 5, 0 for any): ");
+            bool sameFloor = InputHandler::readBool("Keep all rooms on one floor? (1: Yes, 0: No): ");
+            bool adjacent = InputHandler::readBool("Rooms of each type next to each other? (1: Yes, 0: No): ");
+
+            hotel.makeGroupBooking(groupName, singles, doubles, suites, checkInDay, nights,
+                                   floorNumber, sameFloor, adjacent);
+            waitForEnter();
+            break;
+        }
+        case 13:
+        {
+            clearScreen();
+            cout << "\t\t\t\t-------------------------\n";
+            cout << "\t\t\t\tBATCH PROCESSING REQUESTS\n";
+            cout << "\t\t\t\t-------------------------\n\n";
+            int timeBudgetMs = InputHandler::readInt("Enter solver time budget in milliseconds: ");
+            if (timeBudgetMs <= 0)
+            {
+                cout << "Invalid time budget! Please enter a positive value.\n";
+                break;
+            }
+            hotel.processBookingRequestsBatch(timeBudgetMs);
+            waitForEnter();
+            break;
+        }
+        case 14:
+        {
+            clearScreen();
+            cout << "\t\t\t\t----------------------\n";
+            cout << "\t\t\t\tSEARCH BOOKING HISTORY\n";
+            cout << "\t\t\t\t----------------------\n\n";
+            int mode = InputHandler::readInt("Search by (1: Room ID, 2: Date range): ");
+            if (mode == 1)
+            {
+                int roomId = InputHandler::readInt("Enter room ID: ");
+                hotel.displayBookingsForRoom(roomId);
+            }
+            else if (mode == 2)
+            {
+                int fromDay = InputHandler::readInt("Enter first day: ");
+                int toDay = InputHandler::readInt("Enter last day: ");
+                hotel.displayBookingsInRange(fromDay, toDay + 1);
+            }
+            else
+            {
+                cout << "Invalid choice! Please enter 1 or 2.\n";
+                break;
+            }
+            waitForEnter();
+            break;
+        }
+        case 15:
+        {
+            clearScreen();
+            cout << "\t\t\t\t---------------\n";
+            cout << "\t\t\t\tADVANCE THE DAY\n";
+            cout << "\t\t\t\t---------------\n\n";
+            hotel.advanceDay();
+            waitForEnter();
+            break;
+        }
+        case 16:
+        {
+            clearScreen();
+            cout << "\t\t\t\t----------------------------\n";
+            cout << "\t\t\t\tDISPLAYING ARCHIVED BOOKINGS\n";
+            cout << "\t\t\t\t----------------------------\n\n";
+            hotel.displayArchivedBookings();
+            waitForEnter();
+            break;
+        }
+        case 17:
+        {
+            clearScreen();
+            cout << "\t\t\t\t---------------\n";
+            cout << "\t\t\t\tEXPORT A REPORT\n";
+            cout << "\t\t\t\t---------------\n\n";
+            int kind = InputHandler::readInt("Report on (1: Rooms, 2: Booking requests, 3: Booking history): ");
+            int format = InputHandler::readInt("Format (0: Table, 1: CSV, 2: JSON Lines): ");
+            if (kind < 1 || kind > 3 || format < REPORT_TABLE || format > REPORT_JSON)
+            {
+                cout << "Invalid choice!\n";
+                break;
+            }
+
+            ReportQuery query((ReportFormat)format, InputHandler::readInt("Rows per page (0 for all): "));
+            if (kind == 3)
+                query.roomId = InputHandler::readInt("Room ID (0 for any): ");
+            else
+                query.floorNumber = InputHandler::readInt("Floor (0 for any): ");
+            query.roomType = InputHandler::readInt("Room type (-1 for any, 0: Single, 1: Double, 2: Suite): ");
+            if (query.roomType > Room::SUITE)
+                query.roomType = -1;
+
+            bool more = true;
+            while (more)
+            {
+                int rows = kind == 1 ? hotel.reportRooms(cout, query) : kind == 2 ? hotel.reportRequests(cout, query)
+                                                                                  : hotel.reportHistory(cout, query);
+                cout << rows << " row(s)\n";
+                more = !query.done && InputHandler::readBool("Show the next page? (1: Yes, 0: No): ");
+            }
+            waitForEnter();
+            break;
+        }
+        case 18:
+        {
+            clearScreen();
+            cout << "\t\t\t\t-----------------\n";
+            cout << "\t\t\t\tOCCUPANCY SUMMARY\n";
+            cout << "\t\t\t\t-----------------\n\n";
+            int days = InputHandler::readInt("Number of days to cover (1-30): ");
+            if (days < 1 || days > MAX_DAYS)
+            {
+                cout << "Invalid number of days!\n";
+                break;
+            }
+            hotel.displayOccupancySummary(days);
+            waitForEnter();
+            break;
+        }
         }
     }
 }